@@ -0,0 +1,384 @@
+/*
+ * File: anytime.cpp
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * This file defines the functions declared in 'anytime.h'.
+ * Notes:
+ * Comments in this file are implementation level.
+ * More details regarding the purpose and use of each function can be found in 'anytime.h'.
+ */
+
+#include "anytime.h"
+#include "tictactoe_helper.h"
+#include "tablebase.h"
+#include "histogram.h"
+#include <algorithm>
+
+// Budget of anytime_cell() calls without their own
+static AnytimeSettings settings = {1000, 0, 16};
+
+// Statistics of the last call on this thread
+static thread_local AnytimeStats last_stats = {0, 0, 0, 0};
+
+// Search state is kept per thread, so several threads can search at once
+
+// Budget of the current search, positions visited so far, and whether the budget ran out
+static thread_local long long deadline = 0;
+static thread_local long long node_limit = 0;
+static thread_local long long search_nodes = 0;
+static thread_local bool stopped = false;
+
+// Best line found at each ply of the current iteration (pv[ply][ply..pv_length[ply]-1]), and the best line of the
+// last finished iteration, which the next one tries first while it follows it
+static thread_local int pv[ANYTIME_MAX_DEPTH + 1][ANYTIME_MAX_DEPTH + 1];
+static thread_local int pv_length[ANYTIME_MAX_DEPTH + 1];
+static thread_local int previous_pv[ANYTIME_MAX_DEPTH + 1];
+static thread_local int previous_length = 0;
+static thread_local bool follow_pv = false;
+
+// Move that last caused a cutoff at each ply (cell + 1, 0 if none), and how often each cell caused cutoffs,
+// weighted by the depth left
+static thread_local int killer_moves[ANYTIME_MAX_DEPTH + 1];
+static thread_local long long history[MAX_CELLS];
+
+// Tables of the board the search last ran on: cells within two of each cell, where each cell comes in the
+// geometry's move order, and the score of a line by the pieces on it
+static thread_local int tables_size = 0;
+static thread_local int tables_win_length = 0;
+static thread_local vector<BoardMask> near_cells;
+static thread_local int order_rank[MAX_CELLS];
+static thread_local int line_weight[MAX_SIZE + 1];
+
+static inline char other(char turn) {
+    return (turn == X) ? O : X;
+}
+
+// Rebuild the tables when the board size changed since this thread last searched
+static void build_tables() {
+    const Geometry &g = geometry();
+    if (tables_size == g.size && tables_win_length == g.win_length) {
+        return;
+    }
+    tables_size = g.size;
+    tables_win_length = g.win_length;
+
+    near_cells.assign(g.cells, BoardMask());
+    for (int cell = 0; cell < g.cells; cell++) {
+        int r = cell / g.size;
+        int c = cell % g.size;
+        for (int dr = -2; dr <= 2; dr++) {
+            for (int dc = -2; dc <= 2; dc++) {
+                int nr = r + dr;
+                int nc = c + dc;
+                if (nr >= 0 && nr < g.size && nc >= 0 && nc < g.size) {
+                    add_cell(near_cells[cell], nr * g.size + nc);
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < g.cells; i++) {
+        order_rank[g.move_order[i]] = i;
+    }
+
+    // 4 times more per extra piece, capped so the sum over every line stays far below ANYTIME_WIN
+    line_weight[0] = 0;
+    for (int count = 1; count <= MAX_SIZE; count++) {
+        line_weight[count] = 1 << min(2 * (count - 1), 16);
+    }
+}
+
+// Score of a position where the search stops, for the player to move. Lines only one player has pieces on count
+// for that player. If the player to move already has all but one piece of such a line, they win with their move.
+static int evaluate(const Position &position, char turn, int ply) {
+    const Geometry &g = geometry();
+    int lines = g.lines.size();
+    int score = 0;
+    bool win_next = false;
+    for (int l = 0; l < lines; l++) {
+        int x = position.x_line[l];
+        int o = position.o_line[l];
+        if (o == 0) {
+            score += line_weight[x];
+            win_next = win_next || (turn == X && x == g.win_length - 1);
+        }
+        else if (x == 0) {
+            score -= line_weight[o];
+            win_next = win_next || (turn == O && o == g.win_length - 1);
+        }
+    }
+    if (win_next) {
+        return ANYTIME_WIN - (ply + 1);
+    }
+    return (turn == X) ? score : -score;
+}
+
+// True if playing the cell completes a line for the team (the team has every other piece of a line through it)
+static inline bool wins_at(const Position &position, int cell, char team) {
+    const Geometry &g = geometry();
+    const uint8_t *own = (team == X) ? position.x_line : position.o_line;
+    const uint8_t *theirs = (team == X) ? position.o_line : position.x_line;
+    const vector<int> &lines = g.cell_lines[cell];
+    for (size_t i = 0; i < lines.size(); i++) {
+        if (own[lines[i]] == g.win_length - 1 && theirs[lines[i]] == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Fill moves with the empty cells within two of a piece (the first cell of the move order on an empty board),
+// in search order: the move of the last iteration's best line, a move that wins, a move that blocks the opponent's
+// win, the killer move of this ply, then by history score and the geometry's move order
+static void ordered_moves(const Position &position, char turn, int ply, int pv_move, MoveList &moves) {
+    const Geometry &g = geometry();
+    const Bitboard &board = position.board;
+    BoardMask occupied = board.x | board.o;
+    moves.count = 0;
+    if (!any_cell(occupied)) {
+        moves.cells[moves.count++] = g.move_order[0];
+        return;
+    }
+
+    BoardMask near = BoardMask();
+    BoardMask pieces = occupied;
+    while (any_cell(pieces)) {
+        near = near | near_cells[pop_cell(pieces)];
+    }
+    near = near & ~occupied & g.full;
+
+    long long scores[MAX_CELLS];
+    int killer = killer_moves[ply] - 1;
+    while (any_cell(near)) {
+        int cell = pop_cell(near);
+        long long score = history[cell] * MAX_CELLS + (MAX_CELLS - order_rank[cell]);
+        if (cell == pv_move) {
+            score = 1LL << 62;
+        }
+        else if (wins_at(position, cell, turn)) {
+            score = 1LL << 61;
+        }
+        else if (wins_at(position, cell, other(turn))) {
+            score = 1LL << 60;
+        }
+        else if (cell == killer) {
+            score = 1LL << 59;
+        }
+
+        // Insertion sort, highest score first
+        int i = moves.count++;
+        while (i > 0 && scores[i - 1] < score) {
+            moves.cells[i] = moves.cells[i - 1];
+            scores[i] = scores[i - 1];
+            i--;
+        }
+        moves.cells[i] = cell;
+        scores[i] = score;
+    }
+}
+
+// True once the time or node budget has run out or the search was told to stop (the clock and the stop flag are
+// read every 64 positions)
+static inline bool out_of_budget() {
+    if (node_limit > 0 && search_nodes >= node_limit) {
+        return true;
+    }
+    if ((search_nodes & 63) != 0) {
+        return false;
+    }
+    return search_stop_requested() || (deadline > 0 && now_ns() >= deadline);
+}
+
+// Alpha-beta search to a fixed depth, scored for the player to move (the other player's score is the negation)
+static int negamax(Position &position, char turn, int depth, int ply, int alpha, int beta) {
+    pv_length[ply] = ply;
+    search_nodes++;
+    if (stopped || out_of_budget()) {
+        stopped = true;
+        return 0;
+    }
+
+    // The player who just moved won, or the grid is full
+    if (position.x_wins + position.o_wins > 0) {
+        return -(ANYTIME_WIN - ply);
+    }
+    if (position.empty == 0) {
+        return 0;
+    }
+    if (depth == 0 || ply == ANYTIME_MAX_DEPTH) {
+        return evaluate(position, turn, ply);
+    }
+
+    // Stay on the last iteration's best line as long as every move so far followed it
+    int pv_move = -1;
+    if (follow_pv && ply < previous_length) {
+        pv_move = previous_pv[ply];
+    }
+    else {
+        follow_pv = false;
+    }
+
+    MoveList moves;
+    ordered_moves(position, turn, ply, pv_move, moves);
+    int best = -ANYTIME_WIN - 1;
+    for (int i = 0; i < moves.count; i++) {
+        int cell = moves.cells[i];
+        if (cell != pv_move) {
+            follow_pv = false;
+        }
+
+        make_move(position, cell, turn);
+        int value = -negamax(position, other(turn), depth - 1, ply + 1, -beta, -alpha);
+        unmake_move(position, cell, turn);
+
+        // A stopped search unwinds without using its unfinished values
+        if (stopped) {
+            return 0;
+        }
+        if (value > best) {
+            best = value;
+        }
+        if (value > alpha) {
+            alpha = value;
+
+            // This move's line replaces the best line of this ply
+            pv[ply][ply] = cell;
+            for (int p = ply + 1; p < pv_length[ply + 1]; p++) {
+                pv[ply][p] = pv[ply + 1][p];
+            }
+            pv_length[ply] = max(pv_length[ply + 1], ply + 1);
+        }
+        if (alpha >= beta) {
+            killer_moves[ply] = cell + 1;
+            history[cell] += (long long)depth * depth;
+            break;
+        }
+    }
+    return best;
+}
+
+int anytime_cell(const Bitboard &board, char AI, long long time_ms, long long nodes, int max_depth) {
+    long long start = now_ns();
+    build_tables();
+    if (max_depth <= 0 || max_depth > ANYTIME_MAX_DEPTH) {
+        max_depth = ANYTIME_MAX_DEPTH;
+    }
+
+    deadline = (time_ms > 0) ? start + time_ms * 1000000 : 0;
+    node_limit = nodes;
+    search_nodes = 0;
+    stopped = false;
+    previous_length = 0;
+    fill(killer_moves, killer_moves + ANYTIME_MAX_DEPTH + 1, 0);
+    fill(history, history + MAX_CELLS, 0);
+
+    // Until an iteration finishes, play the first move the search would try
+    Position position = to_position(board);
+    MoveList first;
+    ordered_moves(position, AI, 0, -1, first);
+    int best_cell = first.cells[0];
+    int best_score = 0;
+    int finished = 0;
+
+    for (int depth = 1; depth <= max_depth; depth++) {
+        follow_pv = true;
+        int score = negamax(position, AI, depth, 0, -ANYTIME_WIN - 1, ANYTIME_WIN + 1);
+        if (stopped) {
+            break;
+        }
+        finished = depth;
+        best_score = score;
+        best_cell = pv[0][0];
+        previous_length = pv_length[0];
+        copy(pv[0], pv[0] + previous_length, previous_pv);
+
+        // A forced result can't change with more depth, and there is nothing past the full board
+        if (abs(score) >= ANYTIME_WIN - ANYTIME_MAX_DEPTH || depth >= position.empty) {
+            break;
+        }
+    }
+
+    last_stats.depth = finished;
+    last_stats.score = (AI == X) ? best_score : -best_score;
+    last_stats.nodes = search_nodes;
+    last_stats.wall_ns = now_ns() - start;
+    return best_cell;
+}
+
+int anytime_cell(const Bitboard &board, char AI, int max_depth) {
+    return anytime_cell(board, AI, settings.time_ms, settings.nodes, max_depth);
+}
+
+void likely_moves(const Bitboard &board, char mover, MoveList &moves) {
+    build_tables();
+    const Geometry &g = geometry();
+    BoardMask occupied = board.x | board.o;
+    moves.count = 0;
+    if (!any_cell(occupied)) {
+        moves.cells[moves.count++] = g.move_order[0];
+        return;
+    }
+
+    BoardMask near = BoardMask();
+    BoardMask pieces = occupied;
+    while (any_cell(pieces)) {
+        near = near | near_cells[pop_cell(pieces)];
+    }
+    near = near & ~occupied & g.full;
+
+    // The mover's score right after each move: a win first, then a block (the opponent's win scores far below
+    // any other position), then by open lines
+    Position position = to_position(board);
+    long long scores[MAX_CELLS];
+    while (any_cell(near)) {
+        int cell = pop_cell(near);
+        long long score;
+        if (wins_at(position, cell, mover)) {
+            score = 1LL << 62;
+        }
+        else if (wins_at(position, cell, other(mover))) {
+            score = 1LL << 61;
+        }
+        else {
+            make_move(position, cell, mover);
+            score = -(long long)evaluate(position, other(mover), 0);
+            unmake_move(position, cell, mover);
+        }
+
+        // Insertion sort, highest score first (the move order breaks ties)
+        int i = moves.count++;
+        while (i > 0 && (scores[i - 1] < score ||
+                         (scores[i - 1] == score && order_rank[moves.cells[i - 1]] > order_rank[cell]))) {
+            moves.cells[i] = moves.cells[i - 1];
+            scores[i] = scores[i - 1];
+            i--;
+        }
+        moves.cells[i] = cell;
+        scores[i] = score;
+    }
+}
+
+bool anytime_board() {
+    return geometry().cells > settings.exact_cells && !tablebase_ready();
+}
+
+AnytimeSettings anytime_settings() {
+    return settings;
+}
+
+void set_anytime_settings(const AnytimeSettings &new_settings) {
+    settings = new_settings;
+
+    // Every move needs a limit, or a large board would search until ANYTIME_MAX_DEPTH
+    if (settings.time_ms <= 0 && settings.nodes <= 0) {
+        settings.time_ms = 1000;
+    }
+}
+
+AnytimeStats last_anytime_stats() {
+    return last_stats;
+}
@@ -0,0 +1,120 @@
+/*
+ * File: anytime.h
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * Anytime search for boards too large to search to the end of the game. The search goes one ply deeper each
+ * iteration (iterative deepening) with alpha-beta pruning and scores the positions where it stops by their open
+ * lines: every line one player has pieces on and the other hasn't is worth more the more pieces it holds.
+ * It stops when the time or node budget runs out, and plays the best move of the last iteration it finished, so a
+ * move never takes much longer than its budget. Each iteration tries the line of best moves of the iteration
+ * before it first, then moves that caused cutoffs (killer moves, and a history score per cell).
+ * Only cells within two of a piece already on the board are searched (the center on an empty board).
+ */
+
+#ifndef _anytime_h
+#define _anytime_h
+
+#include "bitboard.h"
+
+using namespace std;
+
+// Deepest iteration the search runs (in plies)
+const int ANYTIME_MAX_DEPTH = 64;
+
+// Score of a won position before the plies it takes are subtracted; open-line scores always stay below it
+const int ANYTIME_WIN = 1000000000;
+
+// Budget of a move and which boards use the anytime search
+struct AnytimeSettings {
+    // Time per move in milliseconds (0 for no limit)
+    long long time_ms;
+
+    // Positions per move (0 for no limit; the search stops at whichever limit comes first)
+    long long nodes;
+
+    // Boards with more cells than this use the anytime search instead of searching to the end (see anytime_board())
+    int exact_cells;
+};
+
+// Statistics of the last anytime_cell() call
+struct AnytimeStats {
+    // Deepest iteration finished (0 if none did), and the score of the move played from X's point of view
+    // (ANYTIME_WIN minus the plies to the end for a forced win among the moves searched)
+    int depth;
+    int score;
+
+    // Positions visited, and wall time of the call in nanoseconds
+    long long nodes;
+    long long wall_ns;
+};
+
+/*
+ * Function: anytime_cell()
+ * Description: Chooses a move by iterative deepening within a budget. Before the first iteration finishes, the
+ *              move is the first one the search would try (a winning move, or a block of the opponent's win, if
+ *              there is one). Several threads may search at once. A search told to stop (see set_search_stop()
+ *              in 'tictactoe_helper.h') returns early with the move of the last iteration it finished.
+ * Parameter(s):
+ *     board: Bitboard of the position (not terminal; the AI must be the player to move).
+ *     AI: Char repersenting which player the AI is.
+ *     time_ms: Time for this move in milliseconds (0 for no limit).
+ *     nodes: Positions for this move (0 for no limit; without either limit the search stops at max_depth).
+ *     max_depth: Deepest iteration to run (0 for ANYTIME_MAX_DEPTH).
+ * Returns: Cell index of the chosen move.
+ */
+int anytime_cell(const Bitboard &board, char AI, long long time_ms, long long nodes, int max_depth);
+
+/*
+ * Function: anytime_cell()
+ * Description: anytime_cell() with the budget of the settings (see set_anytime_settings()).
+ * Parameter(s):
+ *     board: Bitboard of the position (not terminal; the AI must be the player to move).
+ *     AI: Char repersenting which player the AI is.
+ *     max_depth: Deepest iteration to run (0 for ANYTIME_MAX_DEPTH).
+ * Returns: Cell index of the chosen move.
+ */
+int anytime_cell(const Bitboard &board, char AI, int max_depth);
+
+/*
+ * Function: likely_moves()
+ * Description: Lists the moves the anytime search would consider for a player (the empty cells within two of a
+ *              piece), most likely first by a one-ply look: a winning move, a block of the opponent's win, then by
+ *              the open lines after the move. Used to guess the human's reply (see 'ponder.h').
+ * Parameter(s):
+ *     board: Bitboard of the position (not terminal).
+ *     mover: Char repersenting the player to move.
+ *     moves: Set to the moves, most likely first.
+ * Returns: Void.
+ */
+void likely_moves(const Bitboard &board, char mover, MoveList &moves);
+
+/*
+ * Function: anytime_board()
+ * Description: Checks if the current board is too large to search to the end: it has more cells than the
+ *              settings' exact_cells and no tablebase is open for it.
+ * Parameter(s):
+ * Returns: Boolean value; true if minimax levels should use anytime_cell().
+ */
+bool anytime_board();
+
+/*
+ * Function: anytime_settings() / set_anytime_settings()
+ * Description: Read or change the anytime search settings. The defaults are 1000 ms per move, no node limit and
+ *              exact search up to 16 cells (4x4). A budget without any limit gets the default time.
+ */
+AnytimeSettings anytime_settings();
+void set_anytime_settings(const AnytimeSettings &settings);
+
+/*
+ * Function: last_anytime_stats()
+ * Description: Returns the statistics of the last anytime_cell() call on this thread.
+ * Parameter(s):
+ * Returns: AnytimeStats of the last call.
+ */
+AnytimeStats last_anytime_stats();
+
+#endif
@@ -0,0 +1,167 @@
+/*
+ * File: batch_eval.cpp
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * This file defines the functions declared in 'batch_eval.h'.
+ * Notes:
+ * Comments in this file are implementation level.
+ * More details regarding the purpose and use of each function can be found in 'batch_eval.h'.
+ */
+
+#include "batch_eval.h"
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BATCH_EVAL_AVX2 1
+#endif
+
+// Evaluation for each combination of (X has a line) | (O has a line) << 1 | (grid is full) << 2
+static const Evaluation outcomes[8] = {
+    {' ', 0, false}, {'X', 1, true}, {'O', -1, true}, {'X', 1, true},
+    {' ', 0, true},  {'X', 1, true}, {'O', -1, true}, {'X', 1, true},
+};
+
+void evaluate_batch_scalar(const Bitboard *boards, size_t count, Evaluation *out) {
+    const Geometry &g = geometry();
+    const vector<BoardMask> &lines = g.lines;
+
+    for (size_t i = 0; i < count; i++) {
+        const Bitboard &board = boards[i];
+
+        // Test every line for both players (no early exit, so X wins ties like the SIMD version)
+        bool x_won = false;
+        bool o_won = false;
+        for (size_t l = 0; l < lines.size(); l++) {
+            x_won |= (board.x & lines[l]) == lines[l];
+            o_won |= (board.o & lines[l]) == lines[l];
+        }
+        bool full = (board.x | board.o) == g.full;
+        out[i] = outcomes[x_won | (o_won << 1) | (full << 2)];
+    }
+}
+
+#ifdef BATCH_EVAL_AVX2
+
+// Runtime check, done once
+static bool avx2_supported() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+// Grids of up to 32 cells: the low 32 bits of 8 boards per register. Returns how many boards were evaluated
+// (a multiple of 8; the caller finishes the rest).
+__attribute__((target("avx2")))
+static size_t evaluate_avx2_32(const Bitboard *boards, size_t count, Evaluation *out) {
+    const Geometry &g = geometry();
+    const vector<BoardMask> &lines = g.lines;
+
+    // Gather indices (in 32-bit units) of the same word in 8 consecutive boards
+    const int stride = sizeof(Bitboard) / sizeof(int);
+    const int o_offset = offsetof(Bitboard, o) / sizeof(int);
+    const __m256i index = _mm256_setr_epi32(0, stride, 2 * stride, 3 * stride, 4 * stride, 5 * stride,
+                                            6 * stride, 7 * stride);
+    const __m256i full = _mm256_set1_epi32((int)g.full.words[0]);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const int *base = (const int *)(boards + i);
+        __m256i x = _mm256_i32gather_epi32(base, index, 4);
+        __m256i o = _mm256_i32gather_epi32(base + o_offset, index, 4);
+
+        // A lane is all ones once that board has the line
+        __m256i x_won = _mm256_setzero_si256();
+        __m256i o_won = _mm256_setzero_si256();
+        for (size_t l = 0; l < lines.size(); l++) {
+            __m256i line = _mm256_set1_epi32((int)lines[l].words[0]);
+            x_won = _mm256_or_si256(x_won, _mm256_cmpeq_epi32(_mm256_and_si256(x, line), line));
+            o_won = _mm256_or_si256(o_won, _mm256_cmpeq_epi32(_mm256_and_si256(o, line), line));
+        }
+        __m256i filled = _mm256_cmpeq_epi32(_mm256_or_si256(x, o), full);
+
+        // One bit per board
+        int x_bits = _mm256_movemask_ps(_mm256_castsi256_ps(x_won));
+        int o_bits = _mm256_movemask_ps(_mm256_castsi256_ps(o_won));
+        int full_bits = _mm256_movemask_ps(_mm256_castsi256_ps(filled));
+        for (int lane = 0; lane < 8; lane++) {
+            int outcome = ((x_bits >> lane) & 1) | (((o_bits >> lane) & 1) << 1) | (((full_bits >> lane) & 1) << 2);
+            out[i + lane] = outcomes[outcome];
+        }
+    }
+    return i;
+}
+
+// Grids of up to 64 cells: the first word of 4 boards per register
+__attribute__((target("avx2")))
+static size_t evaluate_avx2_64(const Bitboard *boards, size_t count, Evaluation *out) {
+    const Geometry &g = geometry();
+    const vector<BoardMask> &lines = g.lines;
+
+    const long long stride = sizeof(Bitboard) / sizeof(long long);
+    const int o_offset = offsetof(Bitboard, o) / sizeof(long long);
+    const __m256i index = _mm256_setr_epi64x(0, stride, 2 * stride, 3 * stride);
+    const __m256i full = _mm256_set1_epi64x((long long)g.full.words[0]);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const long long *base = (const long long *)(boards + i);
+        __m256i x = _mm256_i64gather_epi64(base, index, 8);
+        __m256i o = _mm256_i64gather_epi64(base + o_offset, index, 8);
+
+        __m256i x_won = _mm256_setzero_si256();
+        __m256i o_won = _mm256_setzero_si256();
+        for (size_t l = 0; l < lines.size(); l++) {
+            __m256i line = _mm256_set1_epi64x((long long)lines[l].words[0]);
+            x_won = _mm256_or_si256(x_won, _mm256_cmpeq_epi64(_mm256_and_si256(x, line), line));
+            o_won = _mm256_or_si256(o_won, _mm256_cmpeq_epi64(_mm256_and_si256(o, line), line));
+        }
+        __m256i filled = _mm256_cmpeq_epi64(_mm256_or_si256(x, o), full);
+
+        int x_bits = _mm256_movemask_pd(_mm256_castsi256_pd(x_won));
+        int o_bits = _mm256_movemask_pd(_mm256_castsi256_pd(o_won));
+        int full_bits = _mm256_movemask_pd(_mm256_castsi256_pd(filled));
+        for (int lane = 0; lane < 4; lane++) {
+            int outcome = ((x_bits >> lane) & 1) | (((o_bits >> lane) & 1) << 1) | (((full_bits >> lane) & 1) << 2);
+            out[i + lane] = outcomes[outcome];
+        }
+    }
+    return i;
+}
+
+#endif
+
+int batch_simd_width() {
+#ifdef BATCH_EVAL_AVX2
+    if (avx2_supported()) {
+        if (geometry().cells <= 32) {
+            return 8;
+        }
+        if (geometry().cells <= 64) {
+            return 4;
+        }
+    }
+#endif
+    return 1;
+}
+
+void evaluate_batch(const Bitboard *boards, size_t count, Evaluation *out) {
+    size_t done = 0;
+
+#ifdef BATCH_EVAL_AVX2
+    // Pick the widest path the CPU and the grid allow
+    int width = batch_simd_width();
+    if (width == 8) {
+        done = evaluate_avx2_32(boards, count, out);
+    }
+    else if (width == 4) {
+        done = evaluate_avx2_64(boards, count, out);
+    }
+#endif
+
+    // The boards left over (or all of them without AVX2)
+    evaluate_batch_scalar(boards + done, count - done, out + done);
+}
@@ -0,0 +1,71 @@
+/*
+ * File: batch_eval.h
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * Scores large arrays of positions at once (winner, utility and whether the game is over), for analytics and
+ * training data, where calling winner() one board at a time is the bottleneck.
+ * On CPUs with AVX2 the positions are tested several at a time: each winning line mask is compared against
+ * 8 boards per instruction (grids of up to 32 cells, e.g. 3x3 to 5x5) or 4 boards per instruction (up to
+ * 64 cells, e.g. up to 8x8). Larger grids and other CPUs use the scalar loop, which gives the same results.
+ * The AVX2 code is compiled for that instruction set on its own and only called after a runtime check, so the
+ * program still runs on CPUs without it (no special compiler flags are needed).
+ */
+
+#ifndef _batch_eval_h
+#define _batch_eval_h
+
+#include "bitboard.h"
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+// Score of one position
+struct Evaluation {
+    // 'X' or 'O' if that player has a complete line, ' ' otherwise
+    char winner;
+
+    // 1 if X has won, -1 if O has won, 0 otherwise
+    int8_t utility;
+
+    // True if a player has won or the grid is full
+    bool terminal;
+};
+
+/*
+ * Function: evaluate_batch()
+ * Description: Scores every position of an array for the current board size (see set_board_size()), using AVX2
+ *              when the CPU supports it. The results match winner(), utility() and terminal() for every position
+ *              a game can reach (if both players had a line, which no game reaches, X is reported).
+ * Parameter(s):
+ *     boards: Array of positions.
+ *     count: Number of positions.
+ *     out: Array of count evaluations to fill.
+ * Returns: Void.
+ */
+void evaluate_batch(const Bitboard *boards, size_t count, Evaluation *out);
+
+/*
+ * Function: evaluate_batch_scalar()
+ * Description: evaluate_batch() without SIMD, one position at a time (the fallback, and a baseline to compare with).
+ * Parameter(s):
+ *     boards: Array of positions.
+ *     count: Number of positions.
+ *     out: Array of count evaluations to fill.
+ * Returns: Void.
+ */
+void evaluate_batch_scalar(const Bitboard *boards, size_t count, Evaluation *out);
+
+/*
+ * Function: batch_simd_width()
+ * Description: Returns how many positions evaluate_batch() tests per instruction on this CPU and board size.
+ * Parameter(s):
+ * Returns: Integer type; 8 or 4 with AVX2, 1 for the scalar loop.
+ */
+int batch_simd_width();
+
+#endif
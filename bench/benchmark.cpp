@@ -0,0 +1,889 @@
+/*
+ * File: bench/benchmark.cpp
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * Benchmark and perft suite for the game engine. Prints one JSON object per line so results from two commits
+ * can be compared with diff or any JSON tool. Exits with 1 if a perft count doesn't match its known total,
+ * if a minimax() call allocates heap memory, if a batch evaluation or a fixed-size search disagrees with the
+ * generic code, if a game record doesn't read back what was written, or if the threat search misses a forced
+ * win or fails to stop one, or if a bulk analysis writes other lines than analyzing one line at a time.
+ *
+ * Build (from the repository root):
+ *     g++ -std=c++17 -O2 -pthread -I. -o benchmark bench/benchmark.cpp $(ls *.cpp | grep -v main.cpp)
+ *
+ * Usage:
+ *     benchmark [--quick]    --quick runs fewer iterations (for a fast sanity check).
+ */
+
+#include "tictactoe_helper.h"
+#include "transposition.h"
+#include "renderer.h"
+#include "mcts.h"
+#include "tablebase.h"
+#include "batch_eval.h"
+#include "game_record.h"
+#include "anytime.h"
+#include "proof_search.h"
+#include "bulk_analysis.h"
+#include "histogram.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sys/stat.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Every heap allocation of the program goes through these, so the allocation check can count them
+static long long allocations = 0;
+
+void *operator new(size_t size) {
+    allocations++;
+    void *memory = malloc(size ? size : 1);
+    if (memory == nullptr) {
+        throw bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void *memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept {
+    free(memory);
+}
+
+// Results are added here so the compiler can't remove the benchmarked calls
+static volatile long long sink = 0;
+
+// Iteration counts are divided by this (--quick raises it)
+static long long iteration_divisor = 1;
+
+// Print one benchmark result
+static void report(const string &group, const string &name, long long iterations, long long total_ns) {
+    cout << "{\"group\":\"" << group << "\",\"name\":\"" << name << "\",\"size\":" << SIZE
+         << ",\"win_length\":" << WIN_LENGTH << ",\"iterations\":" << iterations
+         << ",\"ns_per_op\":" << (double)total_ns / iterations << "}" << endl;
+}
+
+// Fixed corpus of positions: random games from a fixed seed, stopped at every ply before the end
+static vector<vector<vector<char> > > make_corpus(int games) {
+    mt19937 rng(12345);
+    vector<vector<vector<char> > > corpus;
+
+    for (int g = 0; g < games; g++) {
+        vector<vector<char> > board = empty_board();
+        while (!terminal(board)) {
+            corpus.push_back(board);
+            set<pair<int, int> > moves = actions(board);
+            vector<pair<int, int> > list(moves.begin(), moves.end());
+            update(board, list[rng() % list.size()], player(board));
+        }
+    }
+    return corpus;
+}
+
+// Time fn over every board of the corpus, repeated until at least `iterations` calls have been made
+template <typename Board, typename Fn>
+static void bench_corpus(const string &name, const vector<Board> &corpus, long long iterations, Fn fn) {
+    long long calls = 0;
+    long long start = now_ns();
+    while (calls < iterations) {
+        for (size_t i = 0; i < corpus.size(); i++) {
+            sink += fn(corpus[i]);
+        }
+        calls += corpus.size();
+    }
+    report("micro", name, calls, now_ns() - start);
+}
+
+// Per-function microbenchmarks on the standard 3x3 game
+static void micro_benchmarks() {
+    set_board_size(3, 3);
+    vector<vector<vector<char> > > corpus = make_corpus(200);
+    vector<Bitboard> bit_corpus;
+    vector<Position> position_corpus;
+    for (size_t i = 0; i < corpus.size(); i++) {
+        bit_corpus.push_back(to_bitboard(corpus[i]));
+        position_corpus.push_back(to_position(bit_corpus.back()));
+    }
+
+    long long n = 2000000 / iteration_divisor;
+
+    // Vector API (what run_game uses)
+    bench_corpus("winner(vector)", corpus, n, [](vector<vector<char> > b) { return (long long)winner(b); });
+    bench_corpus("terminal(vector)", corpus, n, [](vector<vector<char> > b) { return (long long)terminal(b); });
+    bench_corpus("player(vector)", corpus, n, [](const vector<vector<char> > &b) { return (long long)player(b); });
+    bench_corpus("actions(vector)", corpus, n / 4, [](vector<vector<char> > b) { return (long long)actions(b).size(); });
+    bench_corpus("result(vector)", corpus, n / 4, [](const vector<vector<char> > &b) {
+        return (long long)result(b, *actions(b).begin())[0][0];
+    });
+
+    // Bitboard API (what the search uses)
+    bench_corpus("winner(bitboard)", bit_corpus, n * 5, [](const Bitboard &b) { return (long long)winner(b); });
+    bench_corpus("terminal(bitboard)", bit_corpus, n * 5, [](const Bitboard &b) { return (long long)terminal(b); });
+    bench_corpus("player(bitboard)", bit_corpus, n * 5, [](const Bitboard &b) { return (long long)player(b); });
+    bench_corpus("empty_cells(bitboard)", bit_corpus, n * 5, [](const Bitboard &b) {
+        return (long long)count_cells(empty_cells(b));
+    });
+    bench_corpus("result(bitboard)", bit_corpus, n * 5, [](const Bitboard &b) {
+        BoardMask empty = empty_cells(b);
+        return (long long)result(b, pop_cell(empty)).x.words[0];
+    });
+    // Position API (line counts kept up to date by make_move())
+    bench_corpus("winner(position)", position_corpus, n * 5, [](const Position &p) { return (long long)winner(p); });
+    bench_corpus("terminal(position)", position_corpus, n * 5, [](const Position &p) {
+        return (long long)terminal(p);
+    });
+    bench_corpus("make_unmake(position)", position_corpus, n * 5, [](const Position &p) {
+        // The corpus never holds a full board, so there is always an empty cell. The corpus itself isn't const,
+        // and the move is taken back before returning.
+        Position &work = const_cast<Position &>(p);
+        BoardMask empty = empty_cells(work.board);
+        int cell = pop_cell(empty);
+        char turn = player(work);
+        make_move(work, cell, turn);
+        long long over = terminal(work);
+        unmake_move(work, cell, turn);
+        return over;
+    });
+    bench_corpus("canonical_key(bitboard)", bit_corpus, n, [](const Bitboard &b) {
+        int symmetry;
+        return (long long)canonical_key(b, symmetry);
+    });
+
+    // Search from every corpus position with an empty table each time (the table is cleared outside the timing)
+    long long calls = 0;
+    long long total = 0;
+    for (size_t i = 0; i < corpus.size() && calls < 2000 / iteration_divisor; i++, calls++) {
+        transposition_table().clear();
+        long long start = now_ns();
+        sink += minimax_search(corpus[i], player(corpus[i])).first;
+        total += now_ns() - start;
+    }
+    report("micro", "minimax_search(cold)", calls, total);
+
+    // The same searches again with whatever the table already holds
+    calls = 0;
+    long long start = now_ns();
+    for (size_t i = 0; i < corpus.size() && calls < 2000 / iteration_divisor; i++, calls++) {
+        sink += minimax_search(corpus[i], player(corpus[i])).first;
+    }
+    report("micro", "minimax_search(warm)", calls, now_ns() - start);
+
+    // minimax() answers from the compile-time table
+    bench_corpus("minimax(table)", corpus, n / 4, [](const vector<vector<char> > &b) {
+        return (long long)minimax(b, player(b)).first;
+    });
+}
+
+// Count every finished game (leaf) and every position (node) below the board
+static void perft(const Bitboard &board, long long &games, long long &nodes) {
+    nodes++;
+    if (terminal(board)) {
+        games++;
+        return;
+    }
+    BoardMask empty = empty_cells(board);
+    while (any_cell(empty)) {
+        perft(result(board, pop_cell(empty)), games, nodes);
+    }
+}
+
+// Same count with moves made and unmade on one Position, where the end-of-game check is O(1)
+static void perft(Position &position, long long &games, long long &nodes) {
+    nodes++;
+    if (terminal(position)) {
+        games++;
+        return;
+    }
+    char turn = player(position);
+    BoardMask empty = empty_cells(position.board);
+    while (any_cell(empty)) {
+        int cell = pop_cell(empty);
+        make_move(position, cell, turn);
+        perft(position, games, nodes);
+        unmake_move(position, cell, turn);
+    }
+}
+
+// Perft counts from several 3x3 positions, checked against the known totals. Returns false on a mismatch.
+static bool perft_suite() {
+    set_board_size(3, 3);
+
+    struct PerftCase {
+        string name;
+        // Moves played (cell indices) to reach the position
+        vector<int> moves;
+        long long games;
+        long long nodes;
+    };
+
+    // Games: 255,168 in total, split 27,732 per corner, 29,592 per edge and 25,872 for the center opening.
+    // Nodes: 549,946 positions in the full game tree (root included).
+    vector<PerftCase> cases = {
+        {"empty", {}, 255168, 549946},
+        {"corner", {0}, 27732, -1},
+        {"edge", {1}, 29592, -1},
+        {"center", {4}, 25872, -1},
+    };
+
+    bool ok = true;
+    for (size_t i = 0; i < cases.size(); i++) {
+        Bitboard board = {BoardMask(), BoardMask()};
+        for (size_t m = 0; m < cases[i].moves.size(); m++) {
+            board = result(board, cases[i].moves[m]);
+        }
+
+        // Copy-make on the bitboard (full win check per node), then make/unmake with line counts
+        for (int incremental = 0; incremental <= 1; incremental++) {
+            long long games = 0;
+            long long nodes = 0;
+            Position position = to_position(board);
+            long long start = now_ns();
+            if (incremental) {
+                perft(position, games, nodes);
+            }
+            else {
+                perft(board, games, nodes);
+            }
+            long long elapsed = now_ns() - start;
+
+            bool match = games == cases[i].games && (cases[i].nodes < 0 || nodes == cases[i].nodes);
+            ok = ok && match;
+            cout << "{\"group\":\"perft\",\"name\":\"" << cases[i].name << "\",\"board\":\""
+                 << (incremental ? "position" : "bitboard") << "\",\"games\":" << games
+                 << ",\"expected_games\":" << cases[i].games << ",\"nodes\":" << nodes
+                 << ",\"ns_per_node\":" << (double)elapsed / nodes << ",\"ok\":" << (match ? "true" : "false")
+                 << "}" << endl;
+        }
+    }
+    return ok;
+}
+
+// Build a vector board from a string of SIZE * SIZE characters ('X', 'O' or '.')
+static vector<vector<char> > parse_board(const string &cells) {
+    vector<vector<char> > board = empty_board();
+    for (int i = 0; i < SIZE * SIZE; i++) {
+        if (cells[i] == 'X' || cells[i] == 'O') {
+            board[i / SIZE][i % SIZE] = cells[i];
+        }
+    }
+    return board;
+}
+
+// End-to-end time of one AI move from representative positions (cold table, as after a restart)
+static void latency_benchmarks() {
+    struct LatencyCase {
+        int size;
+        int win_length;
+        string name;
+        string cells;
+    };
+
+    vector<LatencyCase> cases = {
+        {3, 3, "3x3 opening", "........."},
+        {3, 3, "3x3 midgame", "X...O...."},
+        {4, 4, "4x4 opening", "................"},
+        {4, 4, "4x4 second move", "X..............."},
+        {4, 4, "4x4 midgame", "X....O....X....."},
+        {4, 3, "4x4 k=3 midgame", ".....X....O....."},
+    };
+
+    for (size_t i = 0; i < cases.size(); i++) {
+        set_board_size(cases[i].size, cases[i].win_length);
+        vector<vector<char> > board = parse_board(cases[i].cells);
+        char turn = player(board);
+
+        // minimax() (table if it applies) and minimax_search(), each from an empty transposition table
+        int repeats = cases[i].size == 3 ? 200 : 3;
+        for (int use_table = 1; use_table >= 0; use_table--) {
+            vector<long long> samples;
+            long long nodes = 0;
+            for (int r = 0; r < repeats; r++) {
+                transposition_table().clear();
+                long long start = now_ns();
+                pair<int, int> move = use_table ? minimax(board, turn) : minimax_search(board, turn);
+                samples.push_back(now_ns() - start);
+                nodes = last_search_stats().nodes;
+                sink += move.first;
+            }
+            sort(samples.begin(), samples.end());
+
+            cout << "{\"group\":\"latency\",\"name\":\"" << cases[i].name << "\",\"function\":\""
+                 << (use_table ? "minimax" : "minimax_search") << "\",\"size\":" << SIZE << ",\"win_length\":"
+                 << WIN_LENGTH << ",\"threads\":" << search_threads() << ",\"nodes\":" << nodes
+                 << ",\"median_us\":" << samples[samples.size() / 2] / 1000.0
+                 << ",\"max_us\":" << samples.back() / 1000.0 << "}" << endl;
+        }
+    }
+}
+
+// Count heap allocations during minimax() and minimax_search() calls (the search makes and unmakes moves on one
+// board with fixed-size move lists, so there should be none). Returns false if any call allocates.
+static bool allocation_check() {
+    struct AllocationCase {
+        int size;
+        int win_length;
+        string cells;
+    };
+    
+    vector<AllocationCase> cases = {
+        {3, 3, "........."},
+        {3, 3, "X...O...."},
+        {4, 4, "X....O....X....."},
+        {4, 3, "................"},
+    };
+    
+    bool ok = true;
+    for (size_t i = 0; i < cases.size(); i++) {
+        set_board_size(cases[i].size, cases[i].win_length);
+        vector<vector<char> > board = parse_board(cases[i].cells);
+        char turn = player(board);
+        
+        for (int use_table = 1; use_table >= 0; use_table--) {
+            // Start from an empty table (it is also allocated on first use, outside the count)
+            transposition_table().clear();
+            
+            long long before = allocations;
+            pair<int, int> move = use_table ? minimax(board, turn) : minimax_search(board, turn);
+            long long made = allocations - before;
+            sink += move.first;
+            
+            ok = ok && made == 0;
+            cout << "{\"group\":\"alloc\",\"name\":\"" << cases[i].cells << "\",\"function\":\""
+                 << (use_table ? "minimax" : "minimax_search") << "\",\"size\":" << SIZE << ",\"win_length\":"
+                 << WIN_LENGTH << ",\"nodes\":" << last_search_stats().nodes << ",\"allocations\":" << made
+                 << ",\"ok\":" << (made == 0 ? "true" : "false") << "}" << endl;
+        }
+    }
+    return ok;
+}
+
+// Cost of redrawing the game screen after one move: bytes and time per frame of the diffing renderer (frames are
+// written to /dev/null), next to the bytes a full clear-and-redraw of the same frame would take
+static void render_benchmarks() {
+    int null_fd = open("/dev/null", O_WRONLY);
+    vector<int> sizes = {3, 9, 16};
+    
+    for (size_t i = 0; i < sizes.size(); i++) {
+        set_board_size(sizes[i], sizes[i] < 5 ? sizes[i] : 5);
+        vector<vector<char> > board = empty_board();
+        Renderer screen(null_fd);
+        
+        // One frame the way run_game draws it
+        auto draw = [&]() {
+            screen.begin_frame();
+            screen.text("PLAYING AS X ");
+            screen.newline();
+            screen.text("------------------");
+            screen.newline();
+            screen.newline();
+            vector<string> lines = board_lines(board);
+            for (size_t l = 0; l < lines.size(); l++) {
+                screen.text(lines[l]);
+                screen.newline();
+            }
+            screen.newline();
+            screen.text("Enter coordinates of move (row, col): ");
+            return screen.present();
+        };
+        
+        // Bytes for the whole frame (as drawn on a cleared screen)
+        size_t full_bytes = draw();
+        
+        // Fill the board one move at a time, one frame per move
+        long long frames = 0;
+        long long bytes = 0;
+        long long start = now_ns();
+        for (int cell = 0; cell < SIZE * SIZE; cell++) {
+            board[cell / SIZE][cell % SIZE] = (cell % 2 == 0) ? X : O;
+            bytes += draw();
+            screen.invalidate_cursor_line();
+            frames++;
+        }
+        long long elapsed = now_ns() - start;
+        
+        cout << "{\"group\":\"render\",\"name\":\"move frame\",\"size\":" << SIZE << ",\"frames\":" << frames
+             << ",\"bytes_per_frame\":" << (double)bytes / frames << ",\"full_frame_bytes\":" << full_bytes
+             << ",\"ns_per_frame\":" << (double)elapsed / frames << "}" << endl;
+    }
+    close(null_fd);
+}
+
+// Playout speed of Monte Carlo Tree Search from the empty board, on one and on two threads
+static void mcts_benchmarks() {
+    vector<pair<int, int> > boards = {{3, 3}, {9, 5}, {15, 5}};
+    MctsSettings original = mcts_settings();
+    
+    for (size_t i = 0; i < boards.size(); i++) {
+        set_board_size(boards[i].first, boards[i].second);
+        Bitboard empty = {BoardMask(), BoardMask()};
+        
+        for (int threads = 1; threads <= 2; threads++) {
+            MctsSettings settings = original;
+            settings.playouts = 100000 / iteration_divisor;
+            settings.time_ms = 0;
+            settings.threads = threads;
+            set_mcts_settings(settings);
+            
+            sink += mcts_cell(empty, X);
+            MctsStats stats = last_mcts_stats();
+            cout << "{\"group\":\"mcts\",\"name\":\"empty board\",\"size\":" << SIZE << ",\"win_length\":"
+                 << WIN_LENGTH << ",\"threads\":" << threads << ",\"playouts\":" << stats.playouts
+                 << ",\"tree_nodes\":" << stats.tree_nodes << ",\"playouts_per_second\":"
+                 << stats.playouts_per_second << "}" << endl;
+        }
+    }
+    set_mcts_settings(original);
+}
+
+// Time to solve and write a tablebase, its size, and the time of one lookup from random positions
+static void tablebase_benchmarks() {
+    vector<pair<int, int> > boards = {{3, 3}, {4, 3}, {4, 4}};
+    string path = "/tmp/tictactoe_benchmark.tb";
+    
+    for (size_t i = 0; i < boards.size(); i++) {
+        // The 4x4 boards take seconds to solve
+        if (iteration_divisor > 1 && boards[i].first > 3) {
+            continue;
+        }
+        set_board_size(boards[i].first, boards[i].second);
+        
+        long long start = now_ns();
+        if (!solve_tablebase(path, search_threads()) || !open_tablebase(path)) {
+            continue;
+        }
+        long long solve_ns = now_ns() - start;
+        struct stat info;
+        stat(path.c_str(), &info);
+        
+        // Lookups from the positions of random games
+        vector<vector<vector<char> > > corpus = make_corpus(200);
+        vector<Bitboard> boards_to_probe;
+        for (size_t b = 0; b < corpus.size(); b++) {
+            boards_to_probe.push_back(to_bitboard(corpus[b]));
+        }
+        long long iterations = 2000000 / iteration_divisor;
+        start = now_ns();
+        for (long long n = 0; n < iterations; n++) {
+            int value;
+            int cell;
+            tablebase_probe(boards_to_probe[n % boards_to_probe.size()], value, cell);
+            sink += cell;
+        }
+        long long probe_ns = now_ns() - start;
+        
+        cout << "{\"group\":\"tablebase\",\"name\":\"solve\",\"size\":" << SIZE << ",\"win_length\":"
+             << WIN_LENGTH << ",\"threads\":" << search_threads() << ",\"solve_ms\":" << solve_ns / 1000000.0
+             << ",\"file_bytes\":" << info.st_size << ",\"probe_ns\":" << (double)probe_ns / iterations << "}"
+             << endl;
+    }
+    unlink(path.c_str());
+}
+
+// Positions of fixed-seed random games, every ply including the finished board
+static vector<Bitboard> random_positions(size_t count) {
+    mt19937 rng(54321);
+    vector<Bitboard> positions;
+    Bitboard empty = {BoardMask(), BoardMask()};
+    while (positions.size() < count) {
+        Position position = to_position(empty);
+        positions.push_back(position.board);
+        while (!terminal(position) && positions.size() < count) {
+            MoveList moves;
+            legal_moves(position.board, moves);
+            make_move(position, moves.cells[rng() % moves.count], player(position));
+            positions.push_back(position.board);
+        }
+    }
+    return positions;
+}
+
+// Positions per second of winner() one board at a time, the scalar batch loop and the SIMD batch.
+// Returns false if a batch result differs from winner(), utility() or terminal().
+static bool batch_benchmarks() {
+    vector<pair<int, int> > boards = {{3, 3}, {4, 4}, {5, 4}, {7, 5}, {9, 5}};
+    bool ok = true;
+
+    for (size_t i = 0; i < boards.size(); i++) {
+        set_board_size(boards[i].first, boards[i].second);
+        vector<Bitboard> positions = random_positions(100000);
+        vector<Evaluation> scalar(positions.size());
+        vector<Evaluation> simd(positions.size());
+        long long rounds = max(1LL, 20 / iteration_divisor);
+
+        // winner() one board at a time
+        long long start = now_ns();
+        for (long long r = 0; r < rounds; r++) {
+            for (size_t p = 0; p < positions.size(); p++) {
+                sink += winner(positions[p]);
+            }
+        }
+        long long winner_ns = now_ns() - start;
+
+        start = now_ns();
+        for (long long r = 0; r < rounds; r++) {
+            evaluate_batch_scalar(positions.data(), positions.size(), scalar.data());
+        }
+        long long scalar_ns = now_ns() - start;
+
+        start = now_ns();
+        for (long long r = 0; r < rounds; r++) {
+            evaluate_batch(positions.data(), positions.size(), simd.data());
+        }
+        long long simd_ns = now_ns() - start;
+
+        // Both batches must agree with the one-board functions
+        bool match = true;
+        for (size_t p = 0; p < positions.size(); p++) {
+            const Bitboard &board = positions[p];
+            for (const Evaluation *e : {&scalar[p], &simd[p]}) {
+                if (e->winner != winner(board) || e->utility != utility(board) || e->terminal != terminal(board)) {
+                    match = false;
+                }
+            }
+        }
+        ok = ok && match;
+
+        double evaluated = (double)rounds * positions.size() * 1e9;
+        cout << "{\"group\":\"batch\",\"name\":\"random positions\",\"size\":" << SIZE << ",\"win_length\":"
+             << WIN_LENGTH << ",\"positions\":" << positions.size() << ",\"simd_width\":" << batch_simd_width()
+             << ",\"winner_per_second\":" << evaluated / winner_ns << ",\"scalar_batch_per_second\":"
+             << evaluated / scalar_ns << ",\"simd_batch_per_second\":" << evaluated / simd_ns
+             << ",\"ok\":" << (match ? "true" : "false") << "}" << endl;
+    }
+    return ok;
+}
+
+// Time of the search compiled for each fixed board size against the generic search, from the same positions with
+// a cold transposition table. Returns false if the two searches disagree on a move or a node count.
+static bool fixed_search_benchmarks() {
+    struct FixedCase {
+        int size;
+        int win_length;
+        string name;
+        string cells;
+    };
+
+    vector<FixedCase> cases = {
+        {3, 3, "3x3 opening", "........."},
+        {4, 3, "4x4 k=3 opening", "................"},
+        {4, 4, "4x4 second move", "X..............."},
+        {5, 3, "5x5 k=3 opening", "........................."},
+        {5, 4, "5x5 k=4 midgame", "XO.OX.XO.X..O.X.O.X.O...."},
+        {5, 5, "5x5 k=5 midgame", "XOXOX.O.X.OXO.X.X.O.O...."},
+    };
+    bool ok = true;
+
+    for (size_t i = 0; i < cases.size(); i++) {
+        set_board_size(cases[i].size, cases[i].win_length);
+        vector<vector<char> > board = parse_board(cases[i].cells);
+        char turn = player(board);
+
+        // Generic search first, then the compiled one; the median of a few runs from an empty table each
+        int repeats = max(1LL, (cases[i].size == 3 ? 200 : 5) / iteration_divisor);
+        long long median_ns[2];
+        long long nodes[2];
+        pair<int, int> moves[2];
+        for (int fixed = 0; fixed <= 1; fixed++) {
+            set_fixed_search(fixed == 1);
+            vector<long long> samples;
+            for (int r = 0; r < repeats; r++) {
+                // A new thread starts without killer moves, so both searches start from the same state
+                transposition_table().clear();
+                thread run([&]() {
+                    long long start = now_ns();
+                    moves[fixed] = minimax_search(board, turn);
+                    samples.push_back(now_ns() - start);
+                    nodes[fixed] = last_search_stats().nodes;
+                });
+                run.join();
+            }
+            sort(samples.begin(), samples.end());
+            median_ns[fixed] = samples[samples.size() / 2];
+        }
+        set_fixed_search(true);
+
+        bool match = moves[0] == moves[1] && nodes[0] == nodes[1];
+        ok = ok && match;
+        cout << "{\"group\":\"fixed\",\"name\":\"" << cases[i].name << "\",\"size\":" << SIZE
+             << ",\"win_length\":" << WIN_LENGTH << ",\"nodes\":" << nodes[1]
+             << ",\"generic_median_us\":" << median_ns[0] / 1000.0 << ",\"fixed_median_us\":"
+             << median_ns[1] / 1000.0 << ",\"speedup\":" << (double)median_ns[0] / median_ns[1]
+             << ",\"ok\":" << (match ? "true" : "false") << "}" << endl;
+    }
+    return ok;
+}
+
+// Games per second written to a game record and replayed from it, on random games of a fixed seed.
+// Returns false if a game reads back differently from how it was written.
+static bool record_benchmarks() {
+    set_board_size(3, 3);
+    string path = "/tmp/tictactoe_benchmark.rec";
+    unlink(path.c_str());
+
+    // Random games, moves stored back to back
+    long long games = 1000000 / iteration_divisor;
+    vector<uint8_t> moves;
+    vector<GameRecord> written;
+    mt19937 rng(2468);
+    Bitboard empty = {BoardMask(), BoardMask()};
+    for (long long g = 0; g < games; g++) {
+        Position position = to_position(empty);
+        GameRecord game = {SIZE, WIN_LENGTH, 'R', 'R', 0, (uint32_t)g, 0, nullptr};
+        while (!terminal(position)) {
+            MoveList legal;
+            legal_moves(position.board, legal);
+            int cell = legal.cells[rng() % legal.count];
+            make_move(position, cell, player(position));
+            moves.push_back(cell);
+            game.move_count++;
+        }
+        char won = winner(position);
+        game.result = (won == X || won == O) ? won : RECORD_TIE;
+        written.push_back(game);
+    }
+    size_t at = 0;
+    for (size_t g = 0; g < written.size(); g++) {
+        written[g].moves = moves.data() + at;
+        at += written[g].move_count;
+    }
+
+    long long start = now_ns();
+    RecordWriter writer;
+    writer.open(path);
+    for (size_t g = 0; g < written.size(); g++) {
+        writer.add(written[g]);
+    }
+    bool match = writer.close();
+    long long write_ns = now_ns() - start;
+    struct stat info;
+    stat(path.c_str(), &info);
+
+    // Read and replay every game, then compare it with the game written
+    start = now_ns();
+    RecordReader reader;
+    match = reader.open(path) && match;
+    GameRecord game;
+    long long read = 0;
+    while (reader.next(game)) {
+        match = match && replay_game(game);
+        read++;
+    }
+    long long replay_ns = now_ns() - start;
+    match = match && read == games && reader.games() == games;
+    size_t blocks = reader.block_count();
+
+    reader.seek_block(0);
+    for (size_t g = 0; match && g < written.size(); g++) {
+        match = reader.next(game) && game.seed == written[g].seed && game.result == written[g].result
+                && game.move_count == written[g].move_count
+                && equal(game.moves, game.moves + game.move_count, written[g].moves);
+    }
+
+    // Random access lands on the right game
+    for (long long g = games / 2; match && g < games; g += games / 7 + 1) {
+        reader.seek_game(g);
+        match = reader.next(game) && game.seed == (uint32_t)g;
+    }
+    reader.close();
+    unlink(path.c_str());
+
+    cout << "{\"group\":\"record\",\"name\":\"random games\",\"size\":" << SIZE << ",\"win_length\":"
+         << WIN_LENGTH << ",\"games\":" << games << ",\"file_bytes\":" << info.st_size
+         << ",\"blocks\":" << blocks
+         << ",\"write_games_per_second\":" << games * 1e9 / write_ns
+         << ",\"replay_games_per_second\":" << games * 1e9 / replay_ns
+         << ",\"ok\":" << (match ? "true" : "false") << "}" << endl;
+    return match;
+}
+
+// Depth the anytime search reaches within a time budget on large boards, and how far past the budget a move ran
+static void anytime_benchmarks() {
+    struct AnytimeCase {
+        int size;
+        int win_length;
+        string name;
+        vector<int> cells;
+    };
+
+    // Moves played in order from the empty board (X first)
+    vector<AnytimeCase> cases = {
+        {9, 5, "9x9 k=5 opening", {40}},
+        {9, 5, "9x9 k=5 midgame", {40, 41, 31, 49, 22, 13, 32, 30, 50}},
+        {15, 5, "15x15 k=5 midgame", {112, 113, 97, 127, 82, 67, 98, 96, 128}},
+    };
+    long long budget_ms = (iteration_divisor > 1) ? 10 : 100;
+
+    for (size_t i = 0; i < cases.size(); i++) {
+        set_board_size(cases[i].size, cases[i].win_length);
+        Bitboard board = {BoardMask(), BoardMask()};
+        for (size_t m = 0; m < cases[i].cells.size(); m++) {
+            make_move(board, cases[i].cells[m], m % 2 == 0 ? X : O);
+        }
+        char turn = player(board);
+
+        long long start = now_ns();
+        int cell = anytime_cell(board, turn, budget_ms, 0, 0);
+        long long elapsed = now_ns() - start;
+        sink += cell;
+        AnytimeStats stats = last_anytime_stats();
+
+        cout << "{\"group\":\"anytime\",\"name\":\"" << cases[i].name << "\",\"size\":" << SIZE
+             << ",\"win_length\":" << WIN_LENGTH << ",\"budget_ms\":" << budget_ms << ",\"depth\":"
+             << stats.depth << ",\"nodes\":" << stats.nodes << ",\"nodes_per_second\":"
+             << stats.nodes * 1e9 / elapsed << ",\"over_budget_ms\":" << elapsed / 1e6 - budget_ms << "}" << endl;
+    }
+}
+
+// Proof-number search speed on 15x15 boards, and whether it finds (and stops) wins by fours it must find
+static bool proof_benchmarks() {
+    struct ProofCase {
+        string name;
+        vector<int> x_cells;
+        vector<int> o_cells;
+        char attacker;
+        ProofResult expected;
+    };
+
+    // Row 7 is cells 105 to 119; X's open three in the middle of it leaves both ends free. The chain of fours
+    // came from random midgames: X wins after some 7,000 expansions, and O has no such win of its own.
+    vector<ProofCase> cases = {
+        {"open three", {112, 113, 114}, {0, 14, 210}, X, PROOF_WIN},
+        {"chain of fours", {66, 80, 160, 98, 130, 142, 84, 125, 140}, {111, 127, 144, 154, 139, 64, 113, 145, 81}, X,
+         PROOF_WIN},
+        {"scattered", {112, 40, 170}, {0, 14, 210}, X, PROOF_NO_WIN},
+    };
+    set_board_size(15, 5);
+    bool ok = true;
+
+    for (size_t i = 0; i < cases.size(); i++) {
+        Bitboard board = {BoardMask(), BoardMask()};
+        for (size_t m = 0; m < cases[i].x_cells.size(); m++) {
+            make_move(board, cases[i].x_cells[m], X);
+        }
+        for (size_t m = 0; m < cases[i].o_cells.size(); m++) {
+            make_move(board, cases[i].o_cells[m], O);
+        }
+
+        int cell;
+        ProofResult result = prove_win(board, cases[i].attacker, 0, 0, cell);
+        ProofStats stats = last_proof_stats();
+        bool match = result == cases[i].expected;
+        ok = ok && match;
+
+        cout << "{\"group\":\"proof\",\"name\":\"" << cases[i].name << "\",\"size\":" << SIZE
+             << ",\"win_length\":" << WIN_LENGTH << ",\"nodes\":" << stats.nodes << ",\"expanded\":"
+             << stats.expanded << ",\"nodes_per_second\":" << stats.nodes_per_second << ",\"node_bytes\":"
+             << stats.node_bytes << ",\"pool_bytes\":" << stats.pool_bytes << ",\"ok\":"
+             << (match ? "true" : "false") << "}" << endl;
+    }
+
+    // O to move against X's open three has to leave X without a win by fours
+    Bitboard board = {BoardMask(), BoardMask()};
+    for (int cell : {112, 113, 114}) {
+        make_move(board, cell, X);
+    }
+    for (int cell : {0, 14}) {
+        make_move(board, cell, O);
+    }
+    long long start = now_ns();
+    int block = threat_cell(board, O, 0, 0);
+    long long elapsed = now_ns() - start;
+    bool stopped = false;
+    if (block >= 0) {
+        make_move(board, block, O);
+        int reply;
+        stopped = prove_win(board, X, 0, 0, reply) != PROOF_WIN;
+    }
+    ok = ok && stopped;
+
+    cout << "{\"group\":\"proof\",\"name\":\"block open three\",\"size\":" << SIZE << ",\"win_length\":"
+         << WIN_LENGTH << ",\"cell\":" << block << ",\"ms\":" << elapsed / 1e6
+         << ",\"ok\":" << (stopped ? "true" : "false") << "}" << endl;
+    return ok;
+}
+
+// Positions per second of a bulk analysis of random 3x3 positions, on one worker and on every core (at least 4).
+// Returns false if either output differs from analyzing the lines one at a time, in order.
+static bool analysis_benchmarks() {
+    set_board_size(3, 3);
+    string input_path = "/tmp/tictactoe_benchmark_positions.txt";
+    string output_path = "/tmp/tictactoe_benchmark_analysis.txt";
+
+    // Board strings of random games, and the output expected for them
+    vector<Bitboard> positions = random_positions(2000000 / iteration_divisor);
+    string input;
+    for (size_t i = 0; i < positions.size(); i++) {
+        for (int cell = 0; cell < geometry().cells; cell++) {
+            input += has_cell(positions[i].x, cell) ? 'X' : has_cell(positions[i].o, cell) ? 'O' : '.';
+        }
+        input += '\n';
+    }
+    ofstream(input_path) << input;
+    string expected;
+    size_t at = 0;
+    while (at < input.size()) {
+        size_t end = input.find('\n', at);
+        analyze_line(input.data() + at, end - at, expected);
+        at = end + 1;
+    }
+
+    bool ok = true;
+    // At least 4 workers, so the output order is checked with chunks finishing out of order even on one core
+    int cores = max(4u, thread::hardware_concurrency());
+    for (int workers : {1, cores}) {
+        AnalysisStats stats;
+        bool match = analyze_file(input_path, output_path, workers, stats);
+        ifstream in(output_path);
+        string output((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+        match = match && output == expected && stats.positions == (long long)positions.size();
+        ok = ok && match;
+
+        cout << "{\"group\":\"analysis\",\"name\":\"random 3x3 positions\",\"workers\":" << workers
+             << ",\"positions\":" << stats.positions << ",\"positions_per_second\":" << stats.positions_per_second
+             << ",\"positions_per_minute\":" << stats.positions_per_second * 60
+             << ",\"ok\":" << (match ? "true" : "false") << "}" << endl;
+    }
+    unlink(input_path.c_str());
+    unlink(output_path.c_str());
+    return ok;
+}
+
+// Runs every benchmark
+int main(int argc, char *argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (string(argv[i]) == "--quick") {
+            iteration_divisor = 20;
+        }
+    }
+
+    micro_benchmarks();
+    bool ok = perft_suite();
+    ok = allocation_check() && ok;
+    ok = batch_benchmarks() && ok;
+    ok = fixed_search_benchmarks() && ok;
+    ok = record_benchmarks() && ok;
+    ok = proof_benchmarks() && ok;
+    ok = analysis_benchmarks() && ok;
+    render_benchmarks();
+    mcts_benchmarks();
+    latency_benchmarks();
+    anytime_benchmarks();
+    tablebase_benchmarks();
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,298 @@
+/*
+ * File: bitboard.cpp
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * This file defines the functions declared in 'bitboard.h'.
+ * Notes:
+ * Comments in this file are implementation level.
+ * More details regarding the purpose and use of each function can be found in 'bitboard.h'.
+ */
+
+#include "bitboard.h"
+#include "tictactoe_helper.h"
+#include "transposition.h"
+#include <algorithm>
+#include <stdexcept>
+
+// Build every table for a size x size grid with win_length in a row to win
+static Geometry build_geometry(int size, int win_length) {
+    Geometry g;
+    g.size = size;
+    g.win_length = win_length;
+    g.cells = size * size;
+
+    g.full = BoardMask();
+    for (int cell = 0; cell < g.cells; cell++) {
+        add_cell(g.full, cell);
+    }
+
+    // Directions of a line: along a row, down a column, down-right diagonal, down-left diagonal
+    const int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+
+    g.cell_lines.resize(g.cells);
+    for (int d = 0; d < 4; d++) {
+        for (int r = 0; r < size; r++) {
+            for (int c = 0; c < size; c++) {
+                // Last cell of a line starting at (r, c)
+                int end_r = r + directions[d][0] * (win_length - 1);
+                int end_c = c + directions[d][1] * (win_length - 1);
+                if (end_r < 0 || end_r >= size || end_c < 0 || end_c >= size) {
+                    continue;
+                }
+
+                // Set every cell of the line and remember the line on each of them
+                BoardMask line = BoardMask();
+                for (int i = 0; i < win_length; i++) {
+                    int cell = (r + directions[d][0] * i) * size + (c + directions[d][1] * i);
+                    add_cell(line, cell);
+                    g.cell_lines[cell].push_back(g.lines.size());
+                }
+                g.lines.push_back(line);
+            }
+        }
+    }
+
+    // Cells that are part of more lines are tried first (for 3x3: center, corners, edges)
+    for (int cell = 0; cell < g.cells; cell++) {
+        g.move_order.push_back(cell);
+    }
+    stable_sort(g.move_order.begin(), g.move_order.end(), [&g](int a, int b) {
+        return g.cell_lines[a].size() > g.cell_lines[b].size();
+    });
+
+    // Rotations, then reflections
+    int last = size - 1;
+    for (int s = 0; s < SYMMETRY_COUNT; s++) {
+        g.symmetry[s].resize(g.cells);
+        g.inverse_symmetry[s].resize(g.cells);
+        for (int cell = 0; cell < g.cells; cell++) {
+            int r = cell / size;
+            int c = cell % size;
+            int new_r = r;
+            int new_c = c;
+
+            switch (s) {
+                case 1: new_r = c;        new_c = last - r; break;
+                case 2: new_r = last - r; new_c = last - c; break;
+                case 3: new_r = last - c; new_c = r;        break;
+                case 4: new_r = r;        new_c = last - c; break;
+                case 5: new_r = last - r; new_c = c;        break;
+                case 6: new_r = c;        new_c = r;        break;
+                case 7: new_r = last - c; new_c = last - r; break;
+            }
+            g.symmetry[s][cell] = new_r * size + new_c;
+            g.inverse_symmetry[s][new_r * size + new_c] = cell;
+        }
+    }
+
+    return g;
+}
+
+// Tables of the current board size (standard 3x3 until set_board_size() is called)
+static Geometry current_geometry = build_geometry(3, 3);
+
+// Rebuild the tables and update the shared size consts
+void set_board_size(int size, int win_length) {
+    if (size < 1 || size > MAX_SIZE || win_length < 1 || win_length > size) {
+        throw invalid_argument("unsupported board size");
+    }
+
+    bool changed = size != current_geometry.size || win_length != current_geometry.win_length;
+    current_geometry = build_geometry(size, win_length);
+    SIZE = size;
+    WIN_LENGTH = win_length;
+
+    // Keys of small boards hold only the pieces, so positions solved on the old board would answer for the new one
+    if (changed) {
+        transposition_table().clear();
+    }
+}
+
+const Geometry &geometry() {
+    return current_geometry;
+}
+
+// Convert a 2D vector into masks
+Bitboard to_bitboard(const vector<vector<char> > &board) {
+    Bitboard bits = {BoardMask(), BoardMask()};
+
+    for (int i = 0; i < SIZE; i++) {
+        for (int j = 0; j < SIZE; j++) {
+            // Set the bit of the player occupying the cell (if any)
+            if (board[i][j] == X) {
+                add_cell(bits.x, i * SIZE + j);
+            }
+            else if (board[i][j] == O) {
+                add_cell(bits.o, i * SIZE + j);
+            }
+        }
+    }
+
+    return bits;
+}
+
+// Convert masks back into a 2D vector
+vector<vector<char> > to_vector(const Bitboard &board) {
+    vector<vector<char> > grid = empty_board();
+
+    for (int i = 0; i < SIZE; i++) {
+        for (int j = 0; j < SIZE; j++) {
+            if (has_cell(board.x, i * SIZE + j)) {
+                grid[i][j] = X;
+            }
+            else if (has_cell(board.o, i * SIZE + j)) {
+                grid[i][j] = O;
+            }
+        }
+    }
+
+    return grid;
+}
+
+// Every cell that neither player occupies
+BoardMask empty_cells(const Bitboard &board) {
+    return current_geometry.full & ~(board.x | board.o);
+}
+
+// X moves first, so it is X's turn whenever both players have the same number of pieces
+char player(const Bitboard &board) {
+    if (count_cells(board.x) <= count_cells(board.o)) {
+        return X;
+    }
+    return O;
+}
+
+// Only test the lines that go through the cell
+bool completes_line(const BoardMask &mask, int cell) {
+    const vector<int> &lines = current_geometry.cell_lines[cell];
+    for (size_t i = 0; i < lines.size(); i++) {
+        const BoardMask &line = current_geometry.lines[lines[i]];
+        if ((mask & line) == line) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// A player has won if all cells of any winning line are theirs
+char winner(const Bitboard &board) {
+    const vector<BoardMask> &lines = current_geometry.lines;
+    for (size_t i = 0; i < lines.size(); i++) {
+        if ((board.x & lines[i]) == lines[i]) {
+            return X;
+        }
+        if ((board.o & lines[i]) == lines[i]) {
+            return O;
+        }
+    }
+
+    // No winner (sentinel value)
+    return ' ';
+}
+
+// Score the board from X's perspective
+int utility(const Bitboard &board) {
+    char winner_ = winner(board);
+    if (winner_ == X) {
+        return 1;
+    }
+    else if (winner_ == O) {
+        return -1;
+    }
+    return 0;
+}
+
+// Game is over when someone has won or there are no empty cells left
+bool terminal(const Bitboard &board) {
+    return winner(board) != ' ' || !any_cell(empty_cells(board));
+}
+
+// Place the current player's piece at cell
+Bitboard result(const Bitboard &board, int cell) {
+    Bitboard next = board;
+    if (player(board) == X) {
+        add_cell(next.x, cell);
+    }
+    else {
+        add_cell(next.o, cell);
+    }
+    return next;
+}
+
+// Count each player's pieces on every line
+Position to_position(const Bitboard &board) {
+    Position position;
+    position.board = board;
+    position.x_pieces = count_cells(board.x);
+    position.o_pieces = count_cells(board.o);
+    position.empty = current_geometry.cells - position.x_pieces - position.o_pieces;
+    position.x_wins = 0;
+    position.o_wins = 0;
+
+    // Only the lines of the current grid are used, so the rest of the arrays is left as is
+    const vector<BoardMask> &lines = current_geometry.lines;
+    for (size_t i = 0; i < lines.size(); i++) {
+        position.x_line[i] = count_cells(board.x & lines[i]);
+        position.o_line[i] = count_cells(board.o & lines[i]);
+        position.x_wins += (position.x_line[i] == current_geometry.win_length);
+        position.o_wins += (position.o_line[i] == current_geometry.win_length);
+    }
+    return position;
+}
+
+// A line is complete when its count reaches win_length
+void make_move(Position &position, int cell, char team) {
+    const vector<int> &lines = current_geometry.cell_lines[cell];
+    uint8_t *counts = (team == X) ? position.x_line : position.o_line;
+    int completed = 0;
+    for (size_t i = 0; i < lines.size(); i++) {
+        completed += (++counts[lines[i]] == current_geometry.win_length);
+    }
+
+    if (team == X) {
+        add_cell(position.board.x, cell);
+        position.x_pieces++;
+        position.x_wins += completed;
+    }
+    else {
+        add_cell(position.board.o, cell);
+        position.o_pieces++;
+        position.o_wins += completed;
+    }
+    position.empty--;
+}
+
+// Exactly undoes make_move()
+void unmake_move(Position &position, int cell, char team) {
+    const vector<int> &lines = current_geometry.cell_lines[cell];
+    uint8_t *counts = (team == X) ? position.x_line : position.o_line;
+    int broken = 0;
+    for (size_t i = 0; i < lines.size(); i++) {
+        broken += (counts[lines[i]]-- == current_geometry.win_length);
+    }
+
+    if (team == X) {
+        remove_cell(position.board.x, cell);
+        position.x_pieces--;
+        position.x_wins -= broken;
+    }
+    else {
+        remove_cell(position.board.o, cell);
+        position.o_pieces--;
+        position.o_wins -= broken;
+    }
+    position.empty++;
+}
+
+// Take empty cells lowest bit first
+void legal_moves(const Bitboard &board, MoveList &moves) {
+    BoardMask empty = empty_cells(board);
+    moves.count = 0;
+    while (any_cell(empty)) {
+        moves.cells[moves.count++] = pop_cell(empty);
+    }
+}
@@ -0,0 +1,365 @@
+/*
+ * File: bitboard.h
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * Compact bitboard representation of the tictactoe board used by the search.
+ * Each player owns one mask; bit (row * SIZE + col) is set when that player occupies (row, col).
+ * The vector<vector<char> > board used by 'tictactoe_helper.h' converts to and from this representation.
+ * Boards can be any size from 1x1 to MAX_SIZE x MAX_SIZE, with any number in a row needed to win
+ * (see set_board_size()).
+ */
+
+#ifndef _bitboard_h
+#define _bitboard_h
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// Largest supported grid (a mask has room for MAX_SIZE * MAX_SIZE cells)
+const int MAX_SIZE = 16;
+const int MAX_CELLS = MAX_SIZE * MAX_SIZE;
+
+// Number of 64 bit words in a mask
+const int MASK_WORDS = MAX_CELLS / 64;
+
+// One bit per cell of the grid
+struct BoardMask {
+    uint64_t words[MASK_WORDS];
+};
+
+// Board state as one mask per player
+struct Bitboard {
+    BoardMask x;
+    BoardMask o;
+};
+
+// Fixed-capacity list of moves (cell indices), so generating moves never allocates
+struct MoveList {
+    int cells[MAX_CELLS];
+    int count;
+};
+
+// Most winning lines a grid can have (one per cell and direction, when a single piece wins)
+const int MAX_LINES = 4 * MAX_CELLS;
+
+// Bitboard plus running counts that make the end of the game an O(1) check.
+// make_move() and unmake_move() keep the counts up to date by touching only the lines through the cell.
+struct Position {
+    Bitboard board;
+
+    // Pieces of each player on each winning line (indexed like Geometry::lines)
+    uint8_t x_line[MAX_LINES];
+    uint8_t o_line[MAX_LINES];
+
+    // Pieces of each player, and empty cells left
+    int x_pieces;
+    int o_pieces;
+    int empty;
+
+    // Lines each player has completed
+    int x_wins;
+    int o_wins;
+};
+
+// Number of symmetries of a square grid (4 rotations, 4 reflections)
+const int SYMMETRY_COUNT = 8;
+
+// Tables describing the current board size, rebuilt by set_board_size()
+struct Geometry {
+    // Width/height of the grid, number in a row needed to win, and SIZE * SIZE
+    int size;
+    int win_length;
+    int cells;
+
+    // Mask with every cell of the grid set
+    BoardMask full;
+
+    // Masks of every winning line (every run of win_length cells in a row, column or diagonal)
+    vector<BoardMask> lines;
+
+    // Indices (into lines) of the lines that go through each cell
+    vector<vector<int> > cell_lines;
+
+    // Cells sorted by how many lines go through them (most first); the search tries moves in this order
+    vector<int> move_order;
+
+    // Where each cell moves to under each symmetry, and where it came from
+    vector<int> symmetry[SYMMETRY_COUNT];
+    vector<int> inverse_symmetry[SYMMETRY_COUNT];
+};
+
+/*
+ * Function: set_board_size()
+ * Description: Changes the size of the grid and the number in a row needed to win, and rebuilds the line,
+ *              symmetry and move order tables. Must be called before any board of the new size is created.
+ *              A different size or win length also empties the transposition table (see 'transposition.h').
+ * Parameter(s):
+ *     size: Width/height of the grid (1 to MAX_SIZE).
+ *     win_length: Number of pieces in a row needed to win (1 to size).
+ * Returns: Void.
+ */
+void set_board_size(int size, int win_length);
+
+/*
+ * Function: geometry()
+ * Description: Returns the tables of the current board size.
+ * Parameter(s):
+ * Returns: Reference to the current Geometry.
+ */
+const Geometry &geometry();
+
+// Bitwise operations on whole masks
+inline BoardMask operator&(const BoardMask &a, const BoardMask &b) {
+    BoardMask mask;
+    for (int i = 0; i < MASK_WORDS; i++) {
+        mask.words[i] = a.words[i] & b.words[i];
+    }
+    return mask;
+}
+
+inline BoardMask operator|(const BoardMask &a, const BoardMask &b) {
+    BoardMask mask;
+    for (int i = 0; i < MASK_WORDS; i++) {
+        mask.words[i] = a.words[i] | b.words[i];
+    }
+    return mask;
+}
+
+// Note: also sets the bits past the last cell, so the result should be combined with Geometry::full
+inline BoardMask operator~(const BoardMask &a) {
+    BoardMask mask;
+    for (int i = 0; i < MASK_WORDS; i++) {
+        mask.words[i] = ~a.words[i];
+    }
+    return mask;
+}
+
+inline bool operator==(const BoardMask &a, const BoardMask &b) {
+    for (int i = 0; i < MASK_WORDS; i++) {
+        if (a.words[i] != b.words[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline bool operator!=(const BoardMask &a, const BoardMask &b) {
+    return !(a == b);
+}
+
+// True if any cell is set
+inline bool any_cell(const BoardMask &mask) {
+    for (int i = 0; i < MASK_WORDS; i++) {
+        if (mask.words[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// True if the cell is set
+inline bool has_cell(const BoardMask &mask, int cell) {
+    return (mask.words[cell >> 6] >> (cell & 63)) & 1;
+}
+
+// Set the cell
+inline void add_cell(BoardMask &mask, int cell) {
+    mask.words[cell >> 6] |= (uint64_t)1 << (cell & 63);
+}
+
+// Clear the cell
+inline void remove_cell(BoardMask &mask, int cell) {
+    mask.words[cell >> 6] &= ~((uint64_t)1 << (cell & 63));
+}
+
+// Number of cells set
+inline int count_cells(const BoardMask &mask) {
+    int count = 0;
+    for (int i = 0; i < MASK_WORDS; i++) {
+        count += __builtin_popcountll(mask.words[i]);
+    }
+    return count;
+}
+
+/*
+ * Function: pop_cell()
+ * Description: Removes the lowest set bit from a mask and returns its cell index.
+ *              Used to iterate over the cells of a mask without scanning the whole grid.
+ * Parameter(s):
+ *     mask: Mask to take the cell from (must not be empty).
+ * Returns: Cell index (row * SIZE + col) of the removed bit.
+ */
+inline int pop_cell(BoardMask &mask) {
+    int i = 0;
+    while (mask.words[i] == 0) {
+        i++;
+    }
+    int cell = (i << 6) + __builtin_ctzll(mask.words[i]);
+    // Clear the lowest set bit
+    mask.words[i] &= mask.words[i] - 1;
+    return cell;
+}
+
+/*
+ * Function: to_bitboard()
+ * Description: Converts a 2D vector board into its bitboard representation.
+ * Parameter(s):
+ *     board: 2D vector of chars repersenting the board.
+ * Returns: Bitboard repersenting the same board.
+ */
+Bitboard to_bitboard(const vector<vector<char> > &board);
+
+/*
+ * Function: to_vector()
+ * Description: Converts a bitboard back into a 2D vector board (used for rendering).
+ * Parameter(s):
+ *     board: Bitboard repersenting the board.
+ * Returns: 2D vector of chars repersenting the board.
+ */
+vector<vector<char> > to_vector(const Bitboard &board);
+
+/*
+ * Function: empty_cells()
+ * Description: Returns the mask of all unoccupied cells; each set bit is an available action.
+ * Parameter(s):
+ *     board: Bitboard repersenting the board.
+ * Returns: Mask of empty cells.
+ */
+BoardMask empty_cells(const Bitboard &board);
+
+/*
+ * Function: player()
+ * Description: Returns which player has the current turn, based on the number of pieces of each player.
+ * Parameter(s):
+ *     board: Bitboard repersenting the board.
+ * Returns: Char repersenting which player has the current turn.
+ */
+char player(const Bitboard &board);
+
+/*
+ * Function: completes_line()
+ * Description: Checks if the cell is part of a winning line fully covered by the mask.
+ *              Only the lines through the cell are tested, so checking the last move is much cheaper than winner().
+ * Parameter(s):
+ *     mask: Mask of one player's pieces.
+ *     cell: Cell index (row * SIZE + col), normally the last move of that player.
+ * Returns: Boolean value; true if a line through the cell is complete, false otherwise.
+ */
+bool completes_line(const BoardMask &mask, int cell);
+
+/*
+ * Function: winner()
+ * Description: Returns which player has won the game by testing every winning line mask.
+ * Parameter(s):
+ *     board: Bitboard repersenting the board.
+ * Returns: Char repersenting which player has won. Returns ' ' as a sentinel value if no player has won.
+ */
+char winner(const Bitboard &board);
+
+/*
+ * Function: utility()
+ * Description: Returns 1 if X wins, -1 if O wins, 0 otherwise.
+ * Parameter(s):
+ *     board: Bitboard repersenting the board.
+ * Returns: Integer type; 1 if X wins, -1 if O wins, 0 otherwise.
+ */
+int utility(const Bitboard &board);
+
+/*
+ * Function: terminal()
+ * Description: Checks if the game is over (a player has won or the grid is full).
+ * Parameter(s):
+ *     board: Bitboard repersenting the board.
+ * Returns: Boolean value; true if game is over, false otherwise.
+ */
+bool terminal(const Bitboard &board);
+
+/*
+ * Function: result()
+ * Description: Returns the board after the current player (see player()) moves at cell.
+ * Parameter(s):
+ *     board: Bitboard repersenting the board.
+ *     cell: Cell index (row * SIZE + col) of the move.
+ * Returns: Bitboard repersenting the new board.
+ */
+Bitboard result(const Bitboard &board, int cell);
+
+/*
+ * Function: make_move() / unmake_move()
+ * Description: Place a piece at cell in place, and take it back again. The search plays every move on one
+ *              board this way instead of copying the board for each child.
+ * Parameter(s):
+ *     board: Bitboard to change.
+ *     cell: Cell index of the move (must be empty for make_move()).
+ *     team: X or O.
+ * Returns: Void.
+ */
+inline void make_move(Bitboard &board, int cell, char team) {
+    add_cell(team == 'X' ? board.x : board.o, cell);
+}
+
+inline void unmake_move(Bitboard &board, int cell, char team) {
+    remove_cell(team == 'X' ? board.x : board.o, cell);
+}
+
+/*
+ * Function: to_position()
+ * Description: Builds a Position with its line counts from a bitboard (scans every line once).
+ * Parameter(s):
+ *     board: Bitboard repersenting the board.
+ * Returns: Position of the same board.
+ */
+Position to_position(const Bitboard &board);
+
+/*
+ * Function: make_move() / unmake_move()
+ * Description: Position versions of the functions above; they also update the counts of the lines through cell.
+ * Parameter(s):
+ *     position: Position to change.
+ *     cell: Cell index of the move (must be empty for make_move()).
+ *     team: X or O.
+ * Returns: Void.
+ */
+void make_move(Position &position, int cell, char team);
+void unmake_move(Position &position, int cell, char team);
+
+// O(1) versions of player(), winner(), utility() and terminal() for a Position
+inline char player(const Position &position) {
+    return (position.x_pieces <= position.o_pieces) ? 'X' : 'O';
+}
+
+inline char winner(const Position &position) {
+    if (position.x_wins > 0) {
+        return 'X';
+    }
+    if (position.o_wins > 0) {
+        return 'O';
+    }
+    return ' ';
+}
+
+inline int utility(const Position &position) {
+    return (position.x_wins > 0) ? 1 : (position.o_wins > 0) ? -1 : 0;
+}
+
+inline bool terminal(const Position &position) {
+    return position.x_wins > 0 || position.o_wins > 0 || position.empty == 0;
+}
+
+/*
+ * Function: legal_moves()
+ * Description: Fills a move list with every empty cell, lowest index first (row-major order).
+ * Parameter(s):
+ *     board: Bitboard repersenting the board.
+ *     moves: Move list to fill (its old contents are replaced).
+ * Returns: Void.
+ */
+void legal_moves(const Bitboard &board, MoveList &moves);
+
+#endif
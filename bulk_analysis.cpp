@@ -0,0 +1,305 @@
+/*
+ * File: bulk_analysis.cpp
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * This file defines the functions declared in 'bulk_analysis.h'.
+ * Notes:
+ * Comments in this file are implementation level.
+ * More details regarding the purpose and use of each function can be found in 'bulk_analysis.h'.
+ */
+
+#include "bulk_analysis.h"
+#include "tictactoe_helper.h"
+#include "anytime.h"
+#include "histogram.h"
+#include <condition_variable>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <mutex>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Chunks each worker may be ahead of the writer, so the finished output waiting to be written stays bounded
+const size_t CHUNKS_AHEAD = 4;
+
+// Append a small integer without going through a stream or a temporary string
+static inline void append_number(string &out, int number) {
+    if (number < 0) {
+        out += '-';
+        number = -number;
+    }
+    char digits[12];
+    int count = 0;
+    do {
+        digits[count++] = '0' + number % 10;
+        number /= 10;
+    } while (number > 0);
+    while (count > 0) {
+        out += digits[--count];
+    }
+}
+
+bool analyze_line(const char *line, size_t length, string &out) {
+    if (length > 0 && line[length - 1] == '\r') {
+        length--;
+    }
+    out.append(line, length);
+
+    // One character per cell, and piece counts that can happen in a game (X moves first)
+    Bitboard board = {BoardMask(), BoardMask()};
+    bool valid = (int)length == geometry().cells;
+    for (size_t i = 0; valid && i < length; i++) {
+        char c = line[i];
+        if (c == 'X' || c == 'x') {
+            make_move(board, i, X);
+        }
+        else if (c == 'O' || c == 'o') {
+            make_move(board, i, O);
+        }
+        else if (c != '.' && c != '-') {
+            valid = false;
+        }
+    }
+    int x_pieces = count_cells(board.x);
+    int o_pieces = count_cells(board.o);
+    if (!valid || (x_pieces != o_pieces && x_pieces != o_pieces + 1)) {
+        out += "\terror\n";
+        return false;
+    }
+
+    // A finished game has its result and no moves
+    if (terminal(board)) {
+        out += '\t';
+        append_number(out, utility(board));
+        out += "\t-1\t\n";
+        return true;
+    }
+
+    // The value is the best move's from the mover's side; the first best move is the one minimax() plays
+    vector<MoveScore> moves = analyze_root(board);
+    int sign = (player(board) == X) ? 1 : -1;
+    size_t best = 0;
+    for (size_t i = 1; i < moves.size(); i++) {
+        if (moves[i].value * sign > moves[best].value * sign) {
+            best = i;
+        }
+    }
+    out += '\t';
+    append_number(out, moves[best].value);
+    out += '\t';
+    append_number(out, moves[best].cell);
+    out += '\t';
+    for (size_t i = 0; i < moves.size(); i++) {
+        if (i > 0) {
+            out += ' ';
+        }
+        append_number(out, moves[i].cell);
+        out += ':';
+        append_number(out, moves[i].value);
+    }
+    out += '\n';
+    return true;
+}
+
+// Read everything left on a file descriptor (for input that can't be mapped, such as a pipe)
+static bool read_all(int fd, string &data) {
+    char buffer[1 << 16];
+    while (true) {
+        ssize_t count = read(fd, buffer, sizeof(buffer));
+        if (count < 0) {
+            return false;
+        }
+        if (count == 0) {
+            return true;
+        }
+        data.append(buffer, count);
+    }
+}
+
+// Write the whole buffer, however many calls it takes
+static bool write_all(int fd, const string &data) {
+    size_t at = 0;
+    while (at < data.size()) {
+        ssize_t count = write(fd, data.data() + at, data.size() - at);
+        if (count < 0) {
+            return false;
+        }
+        at += count;
+    }
+    return true;
+}
+
+// Offset of the first line of a chunk: the first line that starts at or after the chunk's first byte
+static size_t chunk_start(const char *data, size_t size, size_t chunk) {
+    size_t at = chunk * ANALYSIS_CHUNK_BYTES;
+    if (at == 0 || at >= size) {
+        return min(at, size);
+    }
+    const void *newline = memchr(data + at - 1, '\n', size - (at - 1));
+    return (newline == nullptr) ? size : (const char *)newline - data + 1;
+}
+
+bool analyze_file(const string &input_path, const string &output_path, int workers, AnalysisStats &stats) {
+    long long start = now_ns();
+    stats = {0, 0, 0, 0};
+    if (anytime_board()) {
+        return false;
+    }
+    workers = max(workers, 1);
+
+    // Map the input, or read it whole if it can't be mapped
+    int input = (input_path == "-") ? STDIN_FILENO : open(input_path.c_str(), O_RDONLY);
+    if (input < 0) {
+        return false;
+    }
+    struct stat info;
+    const char *data = nullptr;
+    size_t size = 0;
+    void *mapping = MAP_FAILED;
+    string copy;
+    if (fstat(input, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, input, 0);
+    }
+    if (mapping != MAP_FAILED) {
+        data = (const char *)mapping;
+        size = info.st_size;
+
+        // The lines are read front to back
+        madvise(mapping, size, MADV_SEQUENTIAL);
+    }
+    else if (read_all(input, copy)) {
+        data = copy.data();
+        size = copy.size();
+    }
+    else {
+        if (input != STDIN_FILENO) {
+            close(input);
+        }
+        return false;
+    }
+    if (input != STDIN_FILENO) {
+        close(input);
+    }
+
+    int output = STDOUT_FILENO;
+    if (!output_path.empty()) {
+        output = open(output_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+    else {
+        cout.flush();
+    }
+    if (output < 0) {
+        if (mapping != MAP_FAILED) {
+            munmap(mapping, size);
+        }
+        return false;
+    }
+
+    // Every worker searches on its own thread; nested pools would only fight over the cores
+    int search_threads_before = search_threads();
+    if (workers > 1 && search_threads_before > 1) {
+        set_search_threads(1);
+    }
+
+    // Finished chunks wait in a ring of buffers until the writer gets to them
+    size_t chunks = (size + ANALYSIS_CHUNK_BYTES - 1) / ANALYSIS_CHUNK_BYTES;
+    size_t window = CHUNKS_AHEAD * workers;
+    vector<string> buffers(window);
+    vector<bool> finished(window, false);
+    mutex state_mutex;
+    condition_variable chunk_finished;
+    condition_variable chunk_written;
+    size_t next_chunk = 0;
+    size_t written = 0;
+    bool failed = false;
+
+    auto work = [&]() {
+        string out;
+        while (true) {
+            size_t chunk;
+            {
+                unique_lock<mutex> lock(state_mutex);
+                chunk_written.wait(lock, [&]() {
+                    return failed || next_chunk >= chunks || next_chunk < written + window;
+                });
+                if (failed || next_chunk >= chunks) {
+                    return;
+                }
+                chunk = next_chunk++;
+            }
+
+            // Every line that starts in the chunk (the last line of the file may have no newline)
+            size_t at = chunk_start(data, size, chunk);
+            size_t end = chunk_start(data, size, chunk + 1);
+            long long positions = 0;
+            long long invalid = 0;
+            out.clear();
+            while (at < end) {
+                const char *newline = (const char *)memchr(data + at, '\n', end - at);
+                size_t line_end = (newline == nullptr) ? end : newline - data;
+                if (!analyze_line(data + at, line_end - at, out)) {
+                    invalid++;
+                }
+                positions++;
+                at = line_end + 1;
+            }
+
+            lock_guard<mutex> lock(state_mutex);
+            buffers[chunk % window].swap(out);
+            finished[chunk % window] = true;
+            stats.positions += positions;
+            stats.invalid += invalid;
+            chunk_finished.notify_all();
+        }
+    };
+    vector<thread> threads;
+    for (int w = 0; w < workers; w++) {
+        threads.emplace_back(work);
+    }
+
+    // Write the chunks in order, each as soon as it is finished
+    string out;
+    for (size_t chunk = 0; chunk < chunks; chunk++) {
+        {
+            unique_lock<mutex> lock(state_mutex);
+            chunk_finished.wait(lock, [&]() {
+                return finished[chunk % window];
+            });
+            out.swap(buffers[chunk % window]);
+            finished[chunk % window] = false;
+            written++;
+            chunk_written.notify_all();
+        }
+        if (!write_all(output, out)) {
+            lock_guard<mutex> lock(state_mutex);
+            failed = true;
+            chunk_written.notify_all();
+            break;
+        }
+    }
+    for (size_t w = 0; w < threads.size(); w++) {
+        threads[w].join();
+    }
+
+    if (search_threads() != search_threads_before) {
+        set_search_threads(search_threads_before);
+    }
+    if (mapping != MAP_FAILED) {
+        munmap(mapping, size);
+    }
+    if (output != STDOUT_FILENO && close(output) < 0) {
+        failed = true;
+    }
+
+    stats.wall_ns = now_ns() - start;
+    stats.positions_per_second = (stats.wall_ns > 0) ? stats.positions * 1e9 / stats.wall_ns : 0;
+    return !failed;
+}
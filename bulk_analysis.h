@@ -0,0 +1,70 @@
+/*
+ * File: bulk_analysis.h
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * Analysis of large files of positions without the game's prompts. The input has one board per line, its cells
+ * in row-major order: X or x, O or o, and . or - for an empty cell (for example "XO.X.O..." on 3x3). Every line
+ * gets one line of output, in the same order as the input:
+ *     board <TAB> value <TAB> best cell <TAB> cell:value cell:value ...
+ * The value is the result with both players playing optimally (1 if X wins, -1 if O wins, 0 if tied), the best
+ * cell is the move minimax() plays (-1 if the game is over), and every legal move follows with its value (see
+ * analyze_root() in 'tictactoe_helper.h'). A line that isn't a position of the current board is written back
+ * followed by <TAB> error.
+ * The input file is memory-mapped and cut into chunks of about ANALYSIS_CHUNK_BYTES at line ends. Worker threads
+ * take chunks in turn and format their output into one buffer per chunk; the calling thread writes the buffers
+ * in input order, each with a single write, while the workers stay at most a few chunks ahead of it.
+ */
+
+#ifndef _bulk_analysis_h
+#define _bulk_analysis_h
+
+#include <cstddef>
+#include <string>
+
+using namespace std;
+
+// Input bytes per chunk handed to a worker (a chunk ends at the first line end after this many bytes)
+const size_t ANALYSIS_CHUNK_BYTES = 64 * 1024;
+
+// Totals of an analyze_file() call
+struct AnalysisStats {
+    // Lines analyzed, and lines that weren't a position of the current board
+    long long positions;
+    long long invalid;
+
+    // Wall time of the call in nanoseconds, and positions per second
+    long long wall_ns;
+    double positions_per_second;
+};
+
+/*
+ * Function: analyze_line()
+ * Description: Analyzes one board string on the current board size and appends its output line (with the
+ *              newline) to out. Several threads may analyze at once.
+ * Parameter(s):
+ *     line: Characters of the line (without the newline; a trailing carriage return is ignored).
+ *     length: Number of characters.
+ *     out: String to append to.
+ * Returns: Boolean value; false if the line isn't a position of the current board (an error line was appended).
+ */
+bool analyze_line(const char *line, size_t length, string &out);
+
+/*
+ * Function: analyze_file()
+ * Description: Analyzes every line of a file on the current board size and writes the output lines in input
+ *              order. Boards too large to solve (see anytime_board() in 'anytime.h') are refused.
+ *              With more than one worker, the search runs on one thread per worker while the call lasts.
+ * Parameter(s):
+ *     input_path: File of board strings ("-" reads standard input to the end first).
+ *     output_path: File to write (created or truncated), or an empty string for standard output.
+ *     workers: Number of worker threads (at least 1).
+ *     stats: Set to the totals of the call.
+ * Returns: Boolean value; false if a file can't be opened or written, or the board is too large.
+ */
+bool analyze_file(const string &input_path, const string &output_path, int workers, AnalysisStats &stats);
+
+#endif
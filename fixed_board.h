@@ -0,0 +1,213 @@
+/*
+ * File: fixed_board.h
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * Compile-time description of an N x N board with K in a row to win: FixedBoard<N, K> holds the winning line masks,
+ * the lines through each cell, the move order and the 8 symmetry permutations as constexpr tables.
+ * The search is instantiated for each FixedBoard it supports (see set_fixed_search() in 'tictactoe_helper.h'),
+ * so every loop over cells, lines and symmetries has a constant trip count the compiler can unroll, and the
+ * masks are single 64 bit words instead of a BoardMask.
+ * The tables are built exactly like Geometry (see 'bitboard.h'), so both describe the same board: same move
+ * order, same symmetries, and the same keys in the transposition table.
+ */
+
+#ifndef _fixed_board_h
+#define _fixed_board_h
+
+#include "bitboard.h"
+#include <cstdint>
+
+using namespace std;
+
+// Tables of an N x N board with K in a row (sizes checked by FixedBoard below)
+template <int N, int K>
+struct FixedTables {
+    static constexpr int CELLS = N * N;
+
+    // Rows and columns hold N - K + 1 lines each, and each diagonal direction (N - K + 1)^2
+    static constexpr int LINE_COUNT = 2 * N * (N - K + 1) + 2 * (N - K + 1) * (N - K + 1);
+
+    // A cell lies on at most K lines in each of the 4 directions
+    static constexpr int MAX_CELL_LINES = 4 * K;
+
+    // Masks of every winning line
+    uint64_t lines[LINE_COUNT];
+
+    // Masks of the lines through each cell, and how many there are
+    uint64_t cell_lines[CELLS][MAX_CELL_LINES];
+    int cell_line_count[CELLS];
+
+    // Cells sorted by how many lines go through them (most first), ties in row-major order
+    int move_order[CELLS];
+
+    // Where each cell moves to under each symmetry, and where it came from
+    int symmetry[SYMMETRY_COUNT][CELLS];
+    int inverse_symmetry[SYMMETRY_COUNT][CELLS];
+
+    // Each byte of a mask moved through each symmetry, so a whole mask moves with one lookup per byte
+    static constexpr int BYTES = (CELLS + 7) / 8;
+    uint64_t byte_moves[SYMMETRY_COUNT][BYTES][256];
+};
+
+// Same construction as build_geometry() in 'bitboard.cpp', evaluated by the compiler
+template <int N, int K>
+constexpr FixedTables<N, K> build_fixed_tables() {
+    FixedTables<N, K> t{};
+    const int cells = N * N;
+    const int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+
+    int line = 0;
+    for (int d = 0; d < 4; d++) {
+        for (int r = 0; r < N; r++) {
+            for (int c = 0; c < N; c++) {
+                int end_r = r + directions[d][0] * (K - 1);
+                int end_c = c + directions[d][1] * (K - 1);
+                if (end_r < 0 || end_r >= N || end_c < 0 || end_c >= N) {
+                    continue;
+                }
+
+                uint64_t mask = 0;
+                for (int i = 0; i < K; i++) {
+                    mask |= 1ULL << ((r + directions[d][0] * i) * N + (c + directions[d][1] * i));
+                }
+                t.lines[line++] = mask;
+                for (int cell = 0; cell < cells; cell++) {
+                    if ((mask >> cell) & 1) {
+                        t.cell_lines[cell][t.cell_line_count[cell]++] = mask;
+                    }
+                }
+            }
+        }
+    }
+
+    // Insertion sort is stable, like the stable_sort of build_geometry()
+    for (int cell = 0; cell < cells; cell++) {
+        int i = cell;
+        while (i > 0 && t.cell_line_count[t.move_order[i - 1]] < t.cell_line_count[cell]) {
+            t.move_order[i] = t.move_order[i - 1];
+            i--;
+        }
+        t.move_order[i] = cell;
+    }
+
+    // Rotations, then reflections
+    int last = N - 1;
+    for (int s = 0; s < SYMMETRY_COUNT; s++) {
+        for (int cell = 0; cell < cells; cell++) {
+            int r = cell / N;
+            int c = cell % N;
+            int new_r = r;
+            int new_c = c;
+
+            switch (s) {
+                case 1: new_r = c;        new_c = last - r; break;
+                case 2: new_r = last - r; new_c = last - c; break;
+                case 3: new_r = last - c; new_c = r;        break;
+                case 4: new_r = r;        new_c = last - c; break;
+                case 5: new_r = last - r; new_c = c;        break;
+                case 6: new_r = c;        new_c = r;        break;
+                case 7: new_r = last - c; new_c = last - r; break;
+            }
+            t.symmetry[s][cell] = new_r * N + new_c;
+            t.inverse_symmetry[s][new_r * N + new_c] = cell;
+        }
+
+        for (int b = 0; b < FixedTables<N, K>::BYTES; b++) {
+            for (int bits = 0; bits < 256; bits++) {
+                uint64_t moved = 0;
+                for (int i = 0; i < 8 && b * 8 + i < cells; i++) {
+                    if ((bits >> i) & 1) {
+                        moved |= 1ULL << t.symmetry[s][b * 8 + i];
+                    }
+                }
+                t.byte_moves[s][b][bits] = moved;
+            }
+        }
+    }
+    return t;
+}
+
+template <int N, int K>
+struct FixedBoard {
+    // Keys pack the X mask and the O mask into one 64 bit word (see board_key() in 'transposition.h')
+    static_assert(N >= 1 && N * N <= 32, "FixedBoard supports boards of up to 32 cells");
+    static_assert(K >= 1 && K <= N, "win length must be 1 to N");
+
+    static constexpr int SIZE = N;
+    static constexpr int WIN_LENGTH = K;
+    static constexpr int CELLS = N * N;
+    static constexpr int LINE_COUNT = FixedTables<N, K>::LINE_COUNT;
+
+    // Mask with every cell of the grid set
+    static constexpr uint64_t FULL = (1ULL << CELLS) - 1;
+
+    static constexpr FixedTables<N, K> TABLES = build_fixed_tables<N, K>();
+
+    /*
+     * Function: completes_line()
+     * Description: Checks if a line through the cell is fully covered by the mask.
+     * Parameter(s):
+     *     mask: Mask of one player's pieces.
+     *     cell: Cell index, normally that player's last move.
+     * Returns: Boolean value; true if a line through the cell is complete.
+     */
+    static inline bool completes_line(uint64_t mask, int cell) {
+        for (int i = 0; i < TABLES.cell_line_count[cell]; i++) {
+            uint64_t line = TABLES.cell_lines[cell][i];
+            if ((mask & line) == line) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /*
+     * Function: transform()
+     * Description: Moves every piece of a mask through one of the 8 symmetries.
+     * Parameter(s):
+     *     mask: Mask of one player's pieces.
+     *     symmetry: Index of the symmetry (0 is the identity).
+     * Returns: The transformed mask.
+     */
+    static inline uint64_t transform(uint64_t mask, int symmetry) {
+        uint64_t moved = 0;
+        for (int b = 0; b < FixedTables<N, K>::BYTES; b++) {
+            moved |= TABLES.byte_moves[symmetry][b][(mask >> (b * 8)) & 0xFF];
+        }
+        return moved;
+    }
+
+    /*
+     * Function: canonical_key()
+     * Description: Smallest key (X mask in the low 32 bits, O mask in the high 32 bits) among the 8 symmetric
+     *              copies of the board. Gives the same key and symmetry as canonical_key() in 'transposition.h'.
+     * Parameter(s):
+     *     x: Mask of X's pieces.
+     *     o: Mask of O's pieces.
+     *     symmetry: Set to the symmetry that turns the board into its canonical form.
+     * Returns: Canonical key of the board.
+     */
+    static inline uint64_t canonical_key(uint64_t x, uint64_t o, int &symmetry) {
+        uint64_t smallest = x | (o << 32);
+        symmetry = 0;
+        for (int s = 1; s < SYMMETRY_COUNT; s++) {
+            uint64_t key = transform(x, s) | (transform(o, s) << 32);
+            if (key < smallest) {
+                smallest = key;
+                symmetry = s;
+            }
+        }
+        return smallest;
+    }
+};
+
+// The standard game: 8 lines, 4 through the center, center first in the move order
+static_assert(FixedBoard<3, 3>::LINE_COUNT == 8, "3x3 has 8 winning lines");
+static_assert(FixedBoard<3, 3>::TABLES.cell_line_count[4] == 4, "4 lines go through the center");
+static_assert(FixedBoard<3, 3>::TABLES.move_order[0] == 4, "the center is tried first");
+
+#endif
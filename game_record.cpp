@@ -0,0 +1,504 @@
+/*
+ * File: game_record.cpp
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * This file defines the functions declared in 'game_record.h'.
+ * Notes:
+ * Comments in this file are implementation level.
+ * More details regarding the purpose and use of each function can be found in 'game_record.h'.
+ */
+
+#include "game_record.h"
+#include "tictactoe_helper.h"
+#include "histogram.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// Whether a block header read at offset at is one of ours and its payload ends within the file
+static bool complete_block(const RecordBlockHeader &header, size_t at, size_t file_bytes) {
+    if (memcmp(header.magic, RECORD_MAGIC, sizeof(header.magic)) != 0 || header.version != RECORD_VERSION) {
+        return false;
+    }
+    return at + sizeof(header) + header.payload_bytes <= file_bytes;
+}
+
+RecordWriter::RecordWriter() : fd(-1), block_games(0), total_games(0), failed(false) {
+    payload.reserve(RECORD_BLOCK_BYTES + RECORD_GAME_HEADER_BYTES + MAX_CELLS);
+}
+
+RecordWriter::~RecordWriter() {
+    close();
+}
+
+bool RecordWriter::open(const string &path) {
+    close();
+    lock_guard<mutex> guard(lock);
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    total_games = 0;
+    failed = false;
+    if (fd < 0) {
+        return false;
+    }
+
+    // Cut off a block left torn by a crash, so the blocks added after it can be read
+    struct stat info;
+    if (fstat(fd, &info) < 0) {
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+    size_t file_bytes = info.st_size;
+    size_t at = 0;
+    RecordBlockHeader header;
+    while (at + sizeof(header) <= file_bytes && pread(fd, &header, sizeof(header), at) == sizeof(header) &&
+           complete_block(header, at, file_bytes)) {
+        at += sizeof(header) + header.payload_bytes;
+    }
+    if (at < file_bytes && ftruncate(fd, at) < 0) {
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+    return true;
+}
+
+bool RecordWriter::add(const GameRecord &game) {
+    if (game.move_count < 0 || game.move_count > 0xFFFF) {
+        return false;
+    }
+    lock_guard<mutex> guard(lock);
+    if (fd < 0) {
+        return false;
+    }
+
+    // Start a new block rather than let this game push the block far past its size
+    size_t bytes = RECORD_GAME_HEADER_BYTES + game.move_count;
+    if (!payload.empty() && payload.size() + bytes > RECORD_BLOCK_BYTES) {
+        write_block();
+    }
+
+    uint8_t header[RECORD_GAME_HEADER_BYTES] = {
+        (uint8_t)game.size, (uint8_t)game.win_length, (uint8_t)game.x_level, (uint8_t)game.o_level,
+        (uint8_t)game.result, 0,
+        (uint8_t)(game.move_count & 0xFF), (uint8_t)(game.move_count >> 8),
+        (uint8_t)(game.seed & 0xFF), (uint8_t)((game.seed >> 8) & 0xFF),
+        (uint8_t)((game.seed >> 16) & 0xFF), (uint8_t)(game.seed >> 24)
+    };
+    payload.insert(payload.end(), header, header + RECORD_GAME_HEADER_BYTES);
+    payload.insert(payload.end(), game.moves, game.moves + game.move_count);
+    block_games++;
+    total_games++;
+    return !failed;
+}
+
+// Header and payload go out in one writev(), so the block lands in the file whole (the caller holds the lock)
+bool RecordWriter::write_block() {
+    if (fd < 0 || payload.empty()) {
+        return !failed;
+    }
+
+    RecordBlockHeader header;
+    memcpy(header.magic, RECORD_MAGIC, sizeof(header.magic));
+    header.version = RECORD_VERSION;
+    header.reserved = 0;
+    header.payload_bytes = payload.size();
+    header.games = block_games;
+
+    iovec parts[2] = {{&header, sizeof(header)}, {payload.data(), payload.size()}};
+    ssize_t expected = sizeof(header) + payload.size();
+    if (writev(fd, parts, 2) != expected) {
+        failed = true;
+    }
+    payload.clear();
+    block_games = 0;
+    return !failed;
+}
+
+bool RecordWriter::flush() {
+    lock_guard<mutex> guard(lock);
+    return write_block();
+}
+
+bool RecordWriter::close() {
+    lock_guard<mutex> guard(lock);
+    if (fd < 0) {
+        return true;
+    }
+    bool written = write_block();
+    ::close(fd);
+    fd = -1;
+    return written;
+}
+
+long long RecordWriter::games() const {
+    lock_guard<mutex> guard(lock);
+    return total_games;
+}
+
+RecordReader::RecordReader() : mapped(nullptr), mapped_bytes(0), total_games(0), block(0), offset(0), block_end(0) {
+}
+
+RecordReader::~RecordReader() {
+    close();
+}
+
+bool RecordReader::open(const string &path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) < 0) {
+        ::close(fd);
+        return false;
+    }
+
+    // An empty file is a valid record with no games (mmap can't map 0 bytes)
+    if (info.st_size > 0) {
+        void *memory = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (memory == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+        mapped = (const uint8_t *)memory;
+        mapped_bytes = info.st_size;
+
+        // The games are read front to back
+        madvise(memory, info.st_size, MADV_SEQUENTIAL);
+    }
+    ::close(fd);
+
+    // Walk the block headers up to the first torn or unknown one; the payloads aren't touched
+    size_t at = 0;
+    while (at + sizeof(RecordBlockHeader) <= mapped_bytes) {
+        RecordBlockHeader header;
+        memcpy(&header, mapped + at, sizeof(header));
+        if (!complete_block(header, at, mapped_bytes)) {
+            break;
+        }
+        block_offsets.push_back(at);
+        block_first_game.push_back(total_games);
+        total_games += header.games;
+        at += sizeof(header) + header.payload_bytes;
+    }
+
+    seek_block(0);
+    return true;
+}
+
+void RecordReader::close() {
+    if (mapped != nullptr) {
+        munmap((void *)mapped, mapped_bytes);
+    }
+    mapped = nullptr;
+    mapped_bytes = 0;
+    block_offsets.clear();
+    block_first_game.clear();
+    total_games = 0;
+    block = 0;
+    offset = 0;
+    block_end = 0;
+}
+
+size_t RecordReader::block_count() const {
+    return block_offsets.size();
+}
+
+long long RecordReader::games() const {
+    return total_games;
+}
+
+void RecordReader::seek_block(size_t index) {
+    block = index;
+    if (block >= block_offsets.size()) {
+        block = block_offsets.size();
+        offset = block_end = 0;
+        return;
+    }
+    RecordBlockHeader header;
+    memcpy(&header, mapped + block_offsets[block], sizeof(header));
+    offset = block_offsets[block] + sizeof(header);
+    block_end = offset + header.payload_bytes;
+}
+
+void RecordReader::seek_game(long long index) {
+    // Last block starting at or before the game
+    size_t found = upper_bound(block_first_game.begin(), block_first_game.end(), index) - block_first_game.begin();
+    if (index < 0 || index >= total_games || found == 0) {
+        seek_block(block_offsets.size());
+        return;
+    }
+    seek_block(found - 1);
+
+    // Skip the games before it by their move counts
+    for (long long skip = index - block_first_game[found - 1]; skip > 0 && offset + RECORD_GAME_HEADER_BYTES <= block_end; skip--) {
+        const uint8_t *bytes = mapped + offset;
+        offset += RECORD_GAME_HEADER_BYTES + (bytes[6] | (bytes[7] << 8));
+    }
+}
+
+// Checks a game against a filter
+static bool passes(const GameRecord &game, const RecordFilter &filter) {
+    return (filter.size == 0 || game.size == filter.size)
+           && (filter.win_length == 0 || game.win_length == filter.win_length)
+           && (filter.result == 0 || game.result == filter.result)
+           && (filter.level == 0 || game.x_level == filter.level || game.o_level == filter.level);
+}
+
+bool RecordReader::next(GameRecord &game, const RecordFilter *filter) {
+    while (true) {
+        // Move on to the next block at the end of this one
+        while (offset >= block_end) {
+            if (block + 1 >= block_offsets.size()) {
+                block = block_offsets.size();
+                return false;
+            }
+            seek_block(block + 1);
+        }
+
+        if (offset + RECORD_GAME_HEADER_BYTES > block_end) {
+            return false;
+        }
+        const uint8_t *bytes = mapped + offset;
+        game.size = bytes[0];
+        game.win_length = bytes[1];
+        game.x_level = bytes[2];
+        game.o_level = bytes[3];
+        game.result = bytes[4];
+        game.move_count = bytes[6] | (bytes[7] << 8);
+        game.seed = bytes[8] | (bytes[9] << 8) | (bytes[10] << 16) | ((uint32_t)bytes[11] << 24);
+        game.moves = bytes + RECORD_GAME_HEADER_BYTES;
+
+        size_t end = offset + RECORD_GAME_HEADER_BYTES + game.move_count;
+        if (end > block_end) {
+            return false;
+        }
+        offset = end;
+
+        if (filter == nullptr || passes(game, *filter)) {
+            return true;
+        }
+    }
+}
+
+bool replay_game(const GameRecord &game) {
+    if (game.size != SIZE || game.win_length != WIN_LENGTH) {
+        try {
+            set_board_size(game.size, game.win_length);
+        }
+        catch (const invalid_argument&) {
+            return false;
+        }
+    }
+
+    int cells = game.size * game.size;
+    Bitboard empty = {BoardMask(), BoardMask()};
+    Position position = to_position(empty);
+    for (int m = 0; m < game.move_count; m++) {
+        int cell = game.moves[m];
+        if (terminal(position) || cell >= cells || has_cell(position.board.x, cell)
+            || has_cell(position.board.o, cell)) {
+            return false;
+        }
+        make_move(position, cell, player(position));
+    }
+
+    if (!terminal(position)) {
+        return game.result == RECORD_UNFINISHED;
+    }
+    char won = winner(position);
+    return game.result == ((won == X || won == O) ? won : RECORD_TIE);
+}
+
+string game_to_text(const GameRecord &game) {
+    string text = "size=" + to_string(game.size) + " win=" + to_string(game.win_length) + " x=" + game.x_level
+                  + " o=" + game.o_level + " result=" + game.result + " seed=" + to_string(game.seed) + ":";
+    for (int m = 0; m < game.move_count; m++) {
+        text += " (" + to_string(game.moves[m] / game.size) + ", " + to_string(game.moves[m] % game.size) + ")";
+    }
+    return text;
+}
+
+bool game_from_text(const string &line, GameRecord &game, vector<uint8_t> &moves) {
+    size_t colon = line.find(':');
+    if (colon == string::npos) {
+        return false;
+    }
+
+    // Header fields, in any order
+    game.size = 0;
+    game.win_length = 0;
+    game.x_level = 0;
+    game.o_level = 0;
+    game.result = 0;
+    game.seed = 0;
+    istringstream fields(line.substr(0, colon));
+    string field;
+    while (fields >> field) {
+        size_t equals = field.find('=');
+        if (equals == string::npos || equals + 1 == field.size()) {
+            return false;
+        }
+        string key = field.substr(0, equals);
+        string value = field.substr(equals + 1);
+        if (key == "size") {
+            game.size = atoi(value.c_str());
+        }
+        else if (key == "win") {
+            game.win_length = atoi(value.c_str());
+        }
+        else if (key == "x") {
+            game.x_level = value[0];
+        }
+        else if (key == "o") {
+            game.o_level = value[0];
+        }
+        else if (key == "result") {
+            game.result = value[0];
+        }
+        else if (key == "seed") {
+            game.seed = strtoul(value.c_str(), nullptr, 10);
+        }
+        else {
+            return false;
+        }
+    }
+    if (game.x_level == 0 || game.o_level == 0 || game.result == 0) {
+        return false;
+    }
+
+    // parse_input() checks the coordinates against the current board
+    try {
+        if (game.size != SIZE || game.win_length != WIN_LENGTH) {
+            set_board_size(game.size, game.win_length);
+        }
+    }
+    catch (const invalid_argument&) {
+        return false;
+    }
+
+    // Every move is "(row, col)"
+    moves.clear();
+    size_t open = line.find('(', colon);
+    while (open != string::npos) {
+        size_t close = line.find(')', open);
+        if (close == string::npos) {
+            return false;
+        }
+        pair<int, int> coordinates;
+        try {
+            coordinates = parse_input(line.substr(open, close - open + 1));
+        }
+        catch (const logic_error&) {
+            return false;
+        }
+        if (coordinates.first < 0) {
+            return false;
+        }
+        moves.push_back(coordinates.first * game.size + coordinates.second);
+        open = line.find('(', close);
+    }
+
+    game.move_count = moves.size();
+    game.moves = moves.data();
+    return true;
+}
+
+long long record_to_text(const string &path, ostream &out) {
+    RecordReader reader;
+    if (!reader.open(path)) {
+        return -1;
+    }
+    long long written = 0;
+    GameRecord game;
+    while (reader.next(game)) {
+        out << game_to_text(game) << "\n";
+        written++;
+    }
+    out.flush();
+    return written;
+}
+
+long long record_from_text(istream &in, const string &path) {
+    // Parse the whole input first, so a bad line leaves the file as it was
+    vector<GameRecord> games;
+    vector<vector<uint8_t> > moves;
+    string line;
+    while (getline(in, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        GameRecord game;
+        moves.emplace_back();
+        if (!game_from_text(line, game, moves.back())) {
+            return -1;
+        }
+        games.push_back(game);
+    }
+
+    RecordWriter writer;
+    if (!writer.open(path)) {
+        return -1;
+    }
+    for (size_t g = 0; g < games.size(); g++) {
+        games[g].moves = moves[g].data();
+        writer.add(games[g]);
+    }
+    return writer.close() ? (long long)games.size() : -1;
+}
+
+bool replay_record(const string &path, const RecordFilter &filter, ostream &out) {
+    RecordReader reader;
+    if (!reader.open(path)) {
+        out << "Could not read " << path << endl;
+        return false;
+    }
+
+    // Games per result (X, O, tie, unfinished), and games that didn't replay
+    long long results[4] = {0, 0, 0, 0};
+    long long replayed = 0;
+    long long invalid = 0;
+    long long start = now_ns();
+    GameRecord game;
+    while (reader.next(game, &filter)) {
+        replayed++;
+        if (!replay_game(game)) {
+            invalid++;
+            continue;
+        }
+        results[game.result == X ? 0 : game.result == O ? 1 : game.result == RECORD_TIE ? 2 : 3]++;
+    }
+    double seconds = (now_ns() - start) / 1e9;
+
+    out << fixed << setprecision(2);
+    out << "Replayed " << replayed << " of " << reader.games() << " games in " << reader.block_count()
+        << " blocks: " << results[0] << " X wins, " << results[1] << " O wins, " << results[2] << " ties, "
+        << results[3] << " unfinished, " << invalid << " invalid" << endl;
+    out << "Time: " << seconds << " s, " << (seconds > 0 ? replayed / seconds : 0) << " games/s" << endl;
+    return invalid == 0;
+}
+
+// Writer games are recorded to (none if nullptr)
+static RecordWriter *recorder = nullptr;
+
+void set_game_record(RecordWriter *writer) {
+    recorder = writer;
+}
+
+RecordWriter *game_record() {
+    return recorder;
+}
@@ -0,0 +1,299 @@
+/*
+ * File: game_record.h
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * Compact binary record of finished games: one byte per move, a 12 byte header per game, and games grouped into
+ * blocks that each start with their own header, so a reader can jump from block to block without decoding games.
+ * Files are append-only: a writer only ever adds whole blocks at the end, so several runs can record into the same
+ * file and a file cut short by a crash still reads up to its last complete block (the next writer cuts the torn
+ * block off before adding its own).
+ *
+ * File layout (all numbers little-endian):
+ *     block: RecordBlockHeader, then `payload_bytes` bytes holding `games` games
+ *     game:  size, win length, X's level, O's level, result, 0, move count (2 bytes), seed (4 bytes),
+ *            then one byte per move (the cell index, row * size + column)
+ * Levels are difficulty letters ('E', 'N', 'I', 'R', ...) or RECORD_HUMAN. Results are X, O, RECORD_TIE or
+ * RECORD_UNFINISHED. The seed is the one the game's random number generator (mt19937) was seeded with, so its
+ * random moves can be played again.
+ * The reader maps the file (read only, shared), and the games it returns point straight into the mapping.
+ */
+
+#ifndef _game_record_h
+#define _game_record_h
+
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Block identification and version
+const char RECORD_MAGIC[4] = {'T', 'T', 'R', 'B'};
+const uint16_t RECORD_VERSION = 1;
+
+// A writer starts a new block once its payload reaches this many bytes
+const size_t RECORD_BLOCK_BYTES = 64 * 1024;
+
+// Bytes of a game before its moves
+const size_t RECORD_GAME_HEADER_BYTES = 12;
+
+// Level of a human player, and results other than a win
+const char RECORD_HUMAN = 'H';
+const char RECORD_TIE = 'T';
+const char RECORD_UNFINISHED = '-';
+
+// Start of every block
+struct RecordBlockHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t payload_bytes;
+    uint32_t games;
+};
+
+// One game. Games read from a file point into the mapping, so they stay valid until the reader closes.
+struct GameRecord {
+    int size;
+    int win_length;
+    char x_level;
+    char o_level;
+    char result;
+    uint32_t seed;
+    int move_count;
+    const uint8_t *moves;
+};
+
+// Which games a reader returns (0 in a field matches anything)
+struct RecordFilter {
+    int size;
+    int win_length;
+    char result;
+
+    // Games where either side played at this level
+    char level;
+};
+
+/*
+ * Class: RecordWriter
+ * Description: Appends games to a record file. Games collect in memory and go to the file one block at a time,
+ *              with a single write per block. Safe to share between threads.
+ */
+class RecordWriter {
+public:
+    RecordWriter();
+
+    // Writes the last block and closes the file
+    ~RecordWriter();
+
+    /*
+     * Function: open()
+     * Description: Opens a file for appending, creating it if it doesn't exist. Closes any file opened before.
+     *              Anything after the last complete block (a block torn by a crash while writing) is cut off first,
+     *              so the new blocks follow the old ones directly.
+     * Parameter(s):
+     *     path: File to append to.
+     * Returns: Boolean value; true if the file is open, false otherwise.
+     */
+    bool open(const string &path);
+
+    /*
+     * Function: add()
+     * Description: Adds a game to the current block, writing the block first if the game doesn't fit.
+     * Parameter(s):
+     *     game: Game to add (at most 65535 moves).
+     * Returns: Boolean value; false if no file is open or writing failed.
+     */
+    bool add(const GameRecord &game);
+
+    /*
+     * Function: flush()
+     * Description: Writes the current block, if it holds any games.
+     * Parameter(s):
+     * Returns: Boolean value; false if writing failed.
+     */
+    bool flush();
+
+    /*
+     * Function: close()
+     * Description: Writes the current block and closes the file.
+     * Parameter(s):
+     * Returns: Boolean value; false if writing failed.
+     */
+    bool close();
+
+    // Games added since the file was opened
+    long long games() const;
+
+private:
+    bool write_block();
+
+    mutable mutex lock;
+    int fd;
+    vector<uint8_t> payload;
+    uint32_t block_games;
+    long long total_games;
+    bool failed;
+};
+
+/*
+ * Class: RecordReader
+ * Description: Reads a record file through mmap. Opening checks every block header and keeps where each block
+ *              starts, so any block can be read on its own; games are decoded only as they're read.
+ */
+class RecordReader {
+public:
+    RecordReader();
+    ~RecordReader();
+
+    /*
+     * Function: open()
+     * Description: Maps a record file and indexes its blocks. Indexing stops at the first block that is cut short
+     *              (for example by a crash while writing) or has an invalid header; the blocks before it are kept.
+     *              Closes any file opened before.
+     * Parameter(s):
+     *     path: File to open.
+     * Returns: Boolean value; false if the file can't be opened or mapped.
+     */
+    bool open(const string &path);
+
+    // Unmaps the file; games read from it are no longer valid
+    void close();
+
+    // Number of complete blocks, and of games in them
+    size_t block_count() const;
+    long long games() const;
+
+    /*
+     * Function: seek_block()
+     * Description: Moves the reader to the first game of a block (block_count() moves it past the end).
+     * Parameter(s):
+     *     block: Index of the block.
+     * Returns: Void.
+     */
+    void seek_block(size_t block);
+
+    /*
+     * Function: seek_game()
+     * Description: Moves the reader to a game, counting from the first game of the file. Only the block the game is
+     *              in is decoded.
+     * Parameter(s):
+     *     index: Index of the game (games() or more moves the reader past the end).
+     * Returns: Void.
+     */
+    void seek_game(long long index);
+
+    /*
+     * Function: next()
+     * Description: Reads the next game that passes the filter.
+     * Parameter(s):
+     *     game: Set to the game read.
+     *     filter: Games to return (see RecordFilter), or nullptr for every game.
+     * Returns: Boolean value; false at the end of the file or at a malformed game.
+     */
+    bool next(GameRecord &game, const RecordFilter *filter = nullptr);
+
+private:
+    const uint8_t *mapped;
+    size_t mapped_bytes;
+
+    // Offset of each block's header, and the number of games before it
+    vector<size_t> block_offsets;
+    vector<long long> block_first_game;
+    long long total_games;
+
+    // Next game to read: its block, its offset, and the end of that block's payload
+    size_t block;
+    size_t offset;
+    size_t block_end;
+};
+
+/*
+ * Function: replay_game()
+ * Description: Plays the moves of a game on its board and checks them. Changes the board size (see
+ *              set_board_size()) if the game was played on another one.
+ * Parameter(s):
+ *     game: Game to replay.
+ * Returns: Boolean value; true if every move is legal, no move comes after the game ended, and the recorded
+ *          result matches the final position; false otherwise.
+ */
+bool replay_game(const GameRecord &game);
+
+/*
+ * Function: game_to_text()
+ * Description: Writes a game as one line of text: "size=N win=K x=L o=L result=R seed=S:" followed by every move
+ *              as (row, col), the notation parse_input() accepts.
+ * Parameter(s):
+ *     game: Game to write.
+ * Returns: The line of text (without a newline).
+ */
+string game_to_text(const GameRecord &game);
+
+/*
+ * Function: game_from_text()
+ * Description: Parses a line written by game_to_text(). Changes the board size (see set_board_size()) to the
+ *              game's, since parse_input() checks the coordinates against it.
+ * Parameter(s):
+ *     line: Line of text.
+ *     game: Set to the game read; its moves point into the moves vector.
+ *     moves: Set to the moves of the game.
+ * Returns: Boolean value; true if the line is a valid game, false otherwise.
+ */
+bool game_from_text(const string &line, GameRecord &game, vector<uint8_t> &moves);
+
+/*
+ * Function: record_to_text()
+ * Description: Writes every game of a record file as text, one line per game.
+ * Parameter(s):
+ *     path: Record file to read.
+ *     out: Stream to write to.
+ * Returns: Number of games written, or -1 if the file can't be read.
+ */
+long long record_to_text(const string &path, ostream &out);
+
+/*
+ * Function: record_from_text()
+ * Description: Appends every game of a text file (one line per game, as written by record_to_text(); blank lines
+ *              and lines starting with '#' are skipped) to a record file.
+ * Parameter(s):
+ *     in: Stream to read.
+ *     path: Record file to append to.
+ * Returns: Number of games written, or -1 if a line isn't a valid game or the file can't be written.
+ */
+long long record_from_text(istream &in, const string &path);
+
+/*
+ * Function: replay_record()
+ * Description: Replays every game of a record file that passes the filter (see replay_game()) and prints how many
+ *              there were, their results, how many failed to replay, and the games replayed per second.
+ * Parameter(s):
+ *     path: Record file to read.
+ *     filter: Games to replay.
+ *     out: Stream to print to.
+ * Returns: Boolean value; true if the file was read and every game replayed, false otherwise.
+ */
+bool replay_record(const string &path, const RecordFilter &filter, ostream &out);
+
+/*
+ * Function: set_game_record()
+ * Description: Sets the writer that self-play, the interactive game and the server add their finished games to.
+ * Parameter(s):
+ *     writer: Open writer, or nullptr to stop recording.
+ * Returns: Void.
+ */
+void set_game_record(RecordWriter *writer);
+
+/*
+ * Function: game_record()
+ * Description: Returns the writer set with set_game_record().
+ * Parameter(s):
+ * Returns: The writer, or nullptr if games aren't recorded.
+ */
+RecordWriter *game_record();
+
+#endif
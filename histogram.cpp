@@ -0,0 +1,100 @@
+/*
+ * File: histogram.cpp
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * This file defines the functions declared in 'histogram.h'.
+ * Notes:
+ * Comments in this file are implementation level.
+ * More details regarding the purpose and use of each function can be found in 'histogram.h'.
+ */
+
+#include "histogram.h"
+#include <cmath>
+
+LatencyHistogram::LatencyHistogram() {
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        counts[i] = 0;
+    }
+    sample_count = 0;
+    sample_total = 0;
+    sample_max = 0;
+}
+
+// Values below 8 get a bucket each; above that, the 3 bits after the leading bit pick one of 8 sub-buckets
+int LatencyHistogram::bucket(uint64_t value) {
+    if (value < HISTOGRAM_SUB_BUCKETS) {
+        return value;
+    }
+    int exponent = 63 - __builtin_clzll(value);
+    int sub = (value >> (exponent - 3)) & (HISTOGRAM_SUB_BUCKETS - 1);
+    return (exponent - 2) * HISTOGRAM_SUB_BUCKETS + sub;
+}
+
+void LatencyHistogram::add(uint64_t value) {
+    counts[bucket(value)]++;
+    sample_count++;
+    sample_total += value;
+    if (value > sample_max) {
+        sample_max = value;
+    }
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other) {
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        counts[i] += other.counts[i];
+    }
+    sample_count += other.sample_count;
+    sample_total += other.sample_total;
+    if (other.sample_max > sample_max) {
+        sample_max = other.sample_max;
+    }
+}
+
+// Walk the buckets until the running count reaches the wanted rank (nearest rank: the smallest sample with at
+// least that fraction of the samples at or below it)
+uint64_t LatencyHistogram::percentile(double fraction) const {
+    if (sample_count == 0) {
+        return 0;
+    }
+
+    uint64_t rank = (uint64_t)ceil(fraction * sample_count);
+    if (rank < 1) {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (int b = 0; b < HISTOGRAM_BUCKETS; b++) {
+        seen += counts[b];
+        if (seen < rank) {
+            continue;
+        }
+
+        // Small values are exact
+        if (b < HISTOGRAM_SUB_BUCKETS) {
+            return b;
+        }
+
+        // Middle of the bucket (never past the largest sample)
+        int exponent = b / HISTOGRAM_SUB_BUCKETS + 2;
+        int sub = b % HISTOGRAM_SUB_BUCKETS;
+        uint64_t low = (uint64_t)(HISTOGRAM_SUB_BUCKETS + sub) << (exponent - 3);
+        uint64_t middle = low + (((uint64_t)1 << (exponent - 3)) >> 1);
+        return middle < sample_max ? middle : sample_max;
+    }
+    return sample_max;
+}
+
+uint64_t LatencyHistogram::count() const {
+    return sample_count;
+}
+
+uint64_t LatencyHistogram::total() const {
+    return sample_total;
+}
+
+uint64_t LatencyHistogram::max() const {
+    return sample_max;
+}
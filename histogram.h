@@ -0,0 +1,87 @@
+/*
+ * File: histogram.h
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * Fixed-size latency histogram. Samples are counted in logarithmic buckets (8 per power of two, so every bucket
+ * is within 12.5% of its neighbours), which keeps memory constant no matter how many samples are added and lets
+ * histograms from several threads be merged before reading percentiles. now_ns() is the clock the durations are
+ * taken with.
+ */
+
+#ifndef _histogram_h
+#define _histogram_h
+
+#include <chrono>
+#include <cstdint>
+
+// 8 buckets for each power of two up to 2^63
+const int HISTOGRAM_SUB_BUCKETS = 8;
+const int HISTOGRAM_BUCKETS = 64 * HISTOGRAM_SUB_BUCKETS;
+
+/*
+ * Function: now_ns()
+ * Description: Reads a steady clock, for measuring durations.
+ * Parameter(s):
+ * Returns: Nanoseconds since an arbitrary fixed point.
+ */
+inline long long now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+class LatencyHistogram {
+public:
+    /*
+     * Function: LatencyHistogram()
+     * Description: Creates an empty histogram.
+     */
+    LatencyHistogram();
+
+    /*
+     * Function: add()
+     * Description: Counts one sample.
+     * Parameter(s):
+     *     value: The sample (usually a duration in nanoseconds).
+     * Returns: Void.
+     */
+    void add(uint64_t value);
+
+    /*
+     * Function: merge()
+     * Description: Adds every sample of another histogram to this one.
+     * Parameter(s):
+     *     other: Histogram to add.
+     * Returns: Void.
+     */
+    void merge(const LatencyHistogram &other);
+
+    /*
+     * Function: percentile()
+     * Description: Returns the value below which the given fraction of the samples fall
+     *              (the middle of the bucket that contains it, so accurate to about 6%).
+     * Parameter(s):
+     *     fraction: Fraction between 0 and 1 (0.5 for the median, 0.99 for p99).
+     * Returns: Approximate percentile, 0 if the histogram is empty.
+     */
+    uint64_t percentile(double fraction) const;
+
+    // Number of samples, their sum and the largest sample
+    uint64_t count() const;
+    uint64_t total() const;
+    uint64_t max() const;
+
+private:
+    // Bucket that holds a value
+    static int bucket(uint64_t value);
+
+    uint64_t counts[HISTOGRAM_BUCKETS];
+    uint64_t sample_count;
+    uint64_t sample_total;
+    uint64_t sample_max;
+};
+
+#endif
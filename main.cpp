@@ -8,18 +8,423 @@
  * Description:
  * Using functions declared in 'tictactoe_helper.h', 
  * determine if human player is playing as 'X' or 'O', then run the game loop
+ *
+ * Usage:
+ *     tictactoe [--size N] [--win K] [--threads T] [--stats] [--stats-json FILE] [--no-ponder]
+ *         Play the game on an N x N grid (default 3) with K in a row to win (default N, at most 5),
+ *         searching with T threads (default 1). --stats shows the AI's search statistics under the board,
+ *         --stats-json writes the statistics of every game to FILE at exit.
+ *         While the human thinks, the AI searches its replies in the background; --no-ponder turns this off.
+ *         Typing ? instead of a move shows the best move.
+ *     tictactoe --temperature D=T ...
+ *         Level D samples its moves from the scored root moves with softmax temperature T (0 always plays the
+ *         best move; defaults E=1.0 and N=0.35). Can be repeated; works with the game, --selfplay and --server.
+ *     tictactoe --mcts LEVELS [--playouts N] [--think-ms MS] [--mcts-threads T] ...
+ *         Levels listed in LEVELS (for example "NI") choose their moves with Monte Carlo Tree Search, running
+ *         N playouts (default 20000) or for MS milliseconds, whichever ends first (0 for no limit), on T threads.
+ *         Works with the game, --selfplay and --server.
+ *     tictactoe [--move-ms MS] [--move-nodes N] [--exact-cells C] [--no-threat-search] ...
+ *         Boards with more than C cells (default 16) are too large to search to the end, so minimax levels search
+ *         them by iterative deepening for at most MS milliseconds (default 1000) or N positions per move (0 for no
+ *         limit), whichever ends first. Levels without a depth limit first spend up to half of it looking for
+ *         forced wins by fours; --no-threat-search turns this off. Works with the game, --selfplay and --server.
+ *     tictactoe --self-check          Check the compile-time solved table against the minimax search.
+ *     tictactoe --selfplay A B [--games G] [--workers W] [--seed S] [--chance D=P] [--temperature D=T] [--size N] [--win K]
+ *         Play G games (default 10000) between difficulty levels A and B ('E', 'N', 'I' or 'R' for random)
+ *         on W threads (default 1) without a screen, and print the results. --chance sets the chance of a
+ *         random move for level D to P percent (can be repeated).
+ *     tictactoe --tournament ENGINES [--rounds R] [--openings P] [--workers W] [--seed S] [--size N] [--win K]
+ *         Play a round-robin tournament between comma-separated engines (levels such as I or N, softmax:T, mcts:P
+ *         for P playouts per move or mcts:Tms for T milliseconds per move, anytime:N or anytime:Tms for the anytime
+ *         search with N positions or T milliseconds per move) from every opening of P plies
+ *         (default 2), each with both colors, R times (default 1), on W threads. Prints Elo ratings, CPU time
+ *         and nodes per move.
+ *     tictactoe --server ADDRESS [--workers W] [--size N] [--win K]
+ *         Serve games over a Unix socket (ADDRESS is a path) or TCP (ADDRESS is [host:]port, default host
+ *         127.0.0.1), computing AI moves on W threads (default 1). See 'server.h' for the protocol.
+ *     tictactoe --solve-tablebase FILE [--size N] [--win K] [--threads T]
+ *         Solve every position of the board (up to 4x4) on T threads and write the tablebase to FILE.
+ *     tictactoe --tablebase FILE ...
+ *         Play perfect minimax moves from a tablebase written by --solve-tablebase (the board must match).
+ *         Works with the game, --selfplay and --server.
+ *     tictactoe --record FILE ...
+ *         Append every finished game to the binary game record FILE (see 'game_record.h').
+ *         Works with the game and --selfplay.
+ *     tictactoe --replay FILE [--filter-result R] [--filter-level D]
+ *         Replay the games of a record, only those ending in R (X, O or T for a tie) or with a side at level D
+ *         if given, check every move and result, and print the totals.
+ *     tictactoe --record-to-text FILE
+ *         Print every game of a record as "size=N win=K x=L o=L result=R seed=S: (row, col) ...".
+ *     tictactoe --record-from-text TEXT FILE
+ *         Append the games of a text file in the same notation to the record FILE.
+ *     tictactoe --analyze FILE [--output OUT] [--workers W] [--size N] [--win K]
+ *         Analyze every board string of FILE ("-" for standard input) on W threads and write each one's value,
+ *         best move and move scores to OUT (default standard output), in input order (see 'bulk_analysis.h').
+ *     tictactoe --cache FILE ...
+ *         Restore the solver's cache of positions from FILE at startup (if it was written for the same board) and
+ *         save it back to FILE at exit. Works with the game and --selfplay.
  */
 
 #include "tictactoe_helper.h"
+#include "perfect_table.h"
+#include "selfplay.h"
+#include "server.h"
+#include "search_stats.h"
+#include "mcts.h"
+#include "tablebase.h"
+#include "ponder.h"
+#include "transposition.h"
+#include "tournament.h"
+#include "game_record.h"
+#include "anytime.h"
+#include "proof_search.h"
+#include "bulk_analysis.h"
+#include <fstream>
 #include <iostream>
 #include <set>
 #include <stdlib.h>
 #include <ctime>
+#include <stdexcept>
 
 using namespace std;
 
 // Runs the game
-int main() {
+int main(int argc, char *argv[]) {
+    // Board size and number in a row to win (-1 means pick from the size)
+    int size = 3;
+    int win_length = -1;
+    
+    // Self-play options (no game is shown when selfplay_a is set)
+    char selfplay_a = 0;
+    char selfplay_b = 0;
+    long long selfplay_games = 10000;
+    unsigned selfplay_seed = 1;
+    
+    // Tournament options (no game is shown when engines are given)
+    vector<EngineConfig> tournament_engines;
+    int tournament_rounds = 1;
+    int opening_plies = 2;
+    
+    // Threads that play self-play or tournament games, or compute the server's AI moves
+    int workers = 1;
+    
+    // Address to serve games on (no game is shown when set)
+    string server_address;
+    
+    // File to write the AI's statistics to at exit (none if empty)
+    string stats_json;
+    
+    // Budget of the levels that use Monte Carlo Tree Search
+    MctsSettings mcts = mcts_settings();
+    
+    // Budget of the anytime search on large boards
+    AnytimeSettings anytime = anytime_settings();
+    
+    // Tablebase to write, or to play from (none if empty)
+    string solve_path;
+    string tablebase_path;
+    
+    // Solver cache to restore at startup and snapshot at exit (none if empty)
+    string cache_path;
+    
+    // Game record to append games to, to replay, or to convert (none if empty)
+    string record_path;
+    string replay_path;
+    string to_text_path;
+    string from_text_path;
+    RecordFilter replay_filter = {0, 0, 0, 0};
+    
+    // File of positions to analyze, and where the analysis goes (standard output if empty)
+    string analyze_path;
+    string output_path;
+    
+    // Read command line options
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        
+        // Self-check mode, no game is played
+        if (arg == "--self-check") {
+            return verify_perfect_table() ? 0 : 1;
+        }
+        else if (arg == "--size" && i + 1 < argc) {
+            size = atoi(argv[++i]);
+        }
+        else if (arg == "--win" && i + 1 < argc) {
+            win_length = atoi(argv[++i]);
+        }
+        else if (arg == "--threads" && i + 1 < argc) {
+            set_search_threads(atoi(argv[++i]));
+        }
+        else if (arg == "--selfplay" && i + 2 < argc) {
+            selfplay_a = toupper(argv[++i][0]);
+            selfplay_b = toupper(argv[++i][0]);
+        }
+        else if (arg == "--mcts" && i + 1 < argc) {
+            // Every level named in the argument (for example "NI") uses MCTS
+            string levels = argv[++i];
+            for (size_t l = 0; l < levels.size(); l++) {
+                set_ai_backend(toupper(levels[l]), BACKEND_MCTS);
+            }
+        }
+        else if (arg == "--playouts" && i + 1 < argc) {
+            mcts.playouts = atoll(argv[++i]);
+        }
+        else if (arg == "--think-ms" && i + 1 < argc) {
+            mcts.time_ms = atoll(argv[++i]);
+        }
+        else if (arg == "--mcts-threads" && i + 1 < argc) {
+            mcts.threads = atoi(argv[++i]);
+        }
+        else if (arg == "--move-ms" && i + 1 < argc) {
+            anytime.time_ms = atoll(argv[++i]);
+        }
+        else if (arg == "--move-nodes" && i + 1 < argc) {
+            anytime.nodes = atoll(argv[++i]);
+        }
+        else if (arg == "--exact-cells" && i + 1 < argc) {
+            anytime.exact_cells = atoi(argv[++i]);
+        }
+        else if (arg == "--no-threat-search") {
+            set_threat_search(false);
+        }
+        else if (arg == "--no-ponder") {
+            set_pondering(false);
+        }
+        else if (arg == "--stats") {
+            set_show_stats(true);
+        }
+        else if (arg == "--stats-json" && i + 1 < argc) {
+            stats_json = argv[++i];
+        }
+        else if (arg == "--solve-tablebase" && i + 1 < argc) {
+            solve_path = argv[++i];
+        }
+        else if (arg == "--tablebase" && i + 1 < argc) {
+            tablebase_path = argv[++i];
+        }
+        else if (arg == "--cache" && i + 1 < argc) {
+            cache_path = argv[++i];
+        }
+        else if (arg == "--record" && i + 1 < argc) {
+            record_path = argv[++i];
+        }
+        else if (arg == "--replay" && i + 1 < argc) {
+            replay_path = argv[++i];
+        }
+        else if (arg == "--filter-result" && i + 1 < argc) {
+            replay_filter.result = toupper(argv[++i][0]);
+        }
+        else if (arg == "--filter-level" && i + 1 < argc) {
+            replay_filter.level = toupper(argv[++i][0]);
+        }
+        else if (arg == "--record-to-text" && i + 1 < argc) {
+            to_text_path = argv[++i];
+        }
+        else if (arg == "--record-from-text" && i + 2 < argc) {
+            from_text_path = argv[++i];
+            record_path = argv[++i];
+        }
+        else if (arg == "--analyze" && i + 1 < argc) {
+            analyze_path = argv[++i];
+        }
+        else if (arg == "--output" && i + 1 < argc) {
+            output_path = argv[++i];
+        }
+        else if (arg == "--server" && i + 1 < argc) {
+            server_address = argv[++i];
+        }
+        else if (arg == "--tournament" && i + 1 < argc) {
+            // Comma-separated engine specs, for example I,N,softmax:0.5,mcts:2000
+            string specs = argv[++i];
+            size_t begin = 0;
+            while (begin <= specs.size()) {
+                size_t end = specs.find(',', begin);
+                if (end == string::npos) {
+                    end = specs.size();
+                }
+                EngineConfig engine;
+                if (!parse_engine(specs.substr(begin, end - begin), engine)) {
+                    cout << "Invalid engine: " << specs.substr(begin, end - begin) << endl;
+                    return 1;
+                }
+                tournament_engines.push_back(engine);
+                begin = end + 1;
+            }
+        }
+        else if (arg == "--rounds" && i + 1 < argc) {
+            tournament_rounds = atoi(argv[++i]);
+        }
+        else if (arg == "--openings" && i + 1 < argc) {
+            opening_plies = atoi(argv[++i]);
+        }
+        else if (arg == "--games" && i + 1 < argc) {
+            selfplay_games = atoll(argv[++i]);
+        }
+        else if (arg == "--workers" && i + 1 < argc) {
+            workers = atoi(argv[++i]);
+        }
+        else if (arg == "--seed" && i + 1 < argc) {
+            selfplay_seed = strtoul(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--chance" && i + 1 < argc) {
+            // Format is D=P, for example N=20
+            string chance = argv[++i];
+            if (chance.size() < 3 || chance[1] != '=') {
+                cout << "Invalid chance: " << chance << endl;
+                return 1;
+            }
+            set_random_move_chance(toupper(chance[0]), atoi(chance.c_str() + 2));
+        }
+        else if (arg == "--temperature" && i + 1 < argc) {
+            // Format is D=T, for example E=0.5
+            string temperature = argv[++i];
+            if (temperature.size() < 3 || temperature[1] != '=') {
+                cout << "Invalid temperature: " << temperature << endl;
+                return 1;
+            }
+            set_move_temperature(toupper(temperature[0]), atof(temperature.c_str() + 2));
+        }
+        else {
+            cout << "Unknown option: " << arg << endl;
+            return 1;
+        }
+    }
+    
+    // Default to the whole row, up to 5 in a row (like gomoku) on large grids
+    if (win_length < 0) {
+        win_length = (size < 5) ? size : 5;
+    }
+    
+    set_mcts_settings(mcts);
+    set_anytime_settings(anytime);
+    
+    // Check the size before anything else uses it
+    try {
+        set_board_size(size, win_length);
+    }
+    catch (const invalid_argument&) {
+        cout << "Unsupported board: size must be 1 to " << MAX_SIZE << " and win length 1 to size." << endl;
+        return 1;
+    }
+    
+    // Work on a game record instead of playing (each game sets its own board size)
+    if (!replay_path.empty()) {
+        return replay_record(replay_path, replay_filter, cout) ? 0 : 1;
+    }
+    if (!to_text_path.empty()) {
+        if (record_to_text(to_text_path, cout) < 0) {
+            cerr << "Could not read " << to_text_path << endl;
+            return 1;
+        }
+        return 0;
+    }
+    if (!from_text_path.empty()) {
+        ifstream in(from_text_path);
+        long long games = in ? record_from_text(in, record_path) : -1;
+        if (games < 0) {
+            cout << "Could not convert " << from_text_path << " (a line isn't a valid game, or "
+                 << record_path << " can't be written)" << endl;
+            return 1;
+        }
+        cout << "Appended " << games << " games to " << record_path << endl;
+        return 0;
+    }
+    
+    // Solve the board offline instead of playing
+    if (!solve_path.empty()) {
+        if (size * size > TABLEBASE_MAX_CELLS) {
+            cout << "The tablebase only supports boards of up to " << TABLEBASE_MAX_CELLS << " cells." << endl;
+            return 1;
+        }
+        if (!solve_tablebase(solve_path, search_threads()) || !open_tablebase(solve_path)) {
+            cout << "Could not write " << solve_path << endl;
+            return 1;
+        }
+        
+        // Result of the game with perfect play, from the empty board
+        int value;
+        int cell;
+        tablebase_probe(to_bitboard(empty_board()), value, cell);
+        cout << "Solved " << size << "x" << size << " (" << win_length << " in a row): "
+             << (value > 0 ? "X wins" : value < 0 ? "O wins" : "tie") << " with perfect play." << endl;
+        return 0;
+    }
+    
+    // Map the tablebase before the first AI move needs it
+    if (!tablebase_path.empty()) {
+        if (!open_tablebase(tablebase_path)) {
+            cout << "Could not open tablebase: " << tablebase_path << endl;
+            return 1;
+        }
+        if (!tablebase_ready()) {
+            cout << "The tablebase was solved for a different board size or win length." << endl;
+            return 1;
+        }
+    }
+    
+    // Restore the positions solved by earlier runs (a missing or mismatched file just starts empty)
+    if (!cache_path.empty()) {
+        transposition_table().load(cache_path);
+    }
+    
+    // Analyze a file of positions instead of playing
+    if (!analyze_path.empty()) {
+        if (anytime_board()) {
+            cout << "Boards of more than " << anytime_settings().exact_cells << " cells are too large to analyze "
+                 << "exactly (see --exact-cells)." << endl;
+            return 1;
+        }
+        AnalysisStats stats;
+        if (!analyze_file(analyze_path, output_path, workers, stats)) {
+            cerr << "Could not analyze " << analyze_path << " (it can't be read, or the output can't be written)"
+                 << endl;
+            return 1;
+        }
+        cerr << "Analyzed " << stats.positions << " positions (" << stats.invalid << " invalid) in "
+             << stats.wall_ns / 1e9 << " s, " << (long long)stats.positions_per_second << " positions/s" << endl;
+        if (!cache_path.empty()) {
+            transposition_table().save(cache_path);
+        }
+        return 0;
+    }
+    
+    // Record every finished game (the last block is written when the writer goes out of scope)
+    RecordWriter recorder;
+    if (!record_path.empty()) {
+        if (!recorder.open(record_path)) {
+            cout << "Could not open " << record_path << endl;
+            return 1;
+        }
+        set_game_record(&recorder);
+    }
+    
+    // Headless self-play instead of a game
+    if (selfplay_a != 0) {
+        SelfPlayResult result = self_play(selfplay_a, selfplay_b, selfplay_games, workers, selfplay_seed);
+        print_self_play(cout, selfplay_a, selfplay_b, result);
+        if (!cache_path.empty()) {
+            transposition_table().save(cache_path);
+        }
+        return 0;
+    }
+    
+    // Round-robin tournament between engines instead of a game
+    if (!tournament_engines.empty()) {
+        if (tournament_engines.size() < 2) {
+            cout << "A tournament needs at least 2 engines." << endl;
+            return 1;
+        }
+        TournamentResult result = run_tournament(tournament_engines, tournament_rounds, opening_plies, workers,
+                                                 selfplay_seed);
+        print_tournament(cout, result);
+        return 0;
+    }
+    
+    // Serve games over a socket instead
+    if (!server_address.empty()) {
+        return run_server(server_address, workers);
+    }
+    
     // Seed rand
     srand(static_cast<unsigned int>(time(nullptr)));
     
@@ -83,5 +488,16 @@ int main() {
         }
     }
     
+    // Snapshot the solved positions for the next run
+    if (!cache_path.empty() && !transposition_table().save(cache_path)) {
+        cout << "Could not write " << cache_path << endl;
+    }
+    
+    // Dump the statistics of every game
+    if (!stats_json.empty()) {
+        ofstream out(stats_json);
+        write_stats_json(out);
+    }
+    
     return 0;
 }
\ No newline at end of file
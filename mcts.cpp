@@ -0,0 +1,496 @@
+/*
+ * File: mcts.cpp
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * This file defines the functions declared in 'mcts.h'.
+ * Notes:
+ * Comments in this file are implementation level.
+ * More details regarding the purpose and use of each function can be found in 'mcts.h'.
+ */
+
+#include "mcts.h"
+#include "thread_pool.h"
+#include "histogram.h"
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Node states: children not created yet, a thread is creating them, children ready
+const int NODE_LEAF = 0;
+const int NODE_EXPANDING = 1;
+const int NODE_EXPANDED = 2;
+
+// What the move into a node did: nothing final, won the game, filled the board
+const char RESULT_NONE = 0;
+const char RESULT_WIN = 1;
+const char RESULT_DRAW = 2;
+
+// One position of the tree. Scores are from the view of the player who made the move into the node:
+// 2 per win and 1 per draw, so the win rate is score / (2 * visits).
+struct MctsNode {
+    atomic<int> visits;
+    atomic<int> score;
+    atomic<int> virtual_loss;
+    atomic<int> state;
+
+    // Children are stored next to each other starting at first_child
+    int first_child;
+    int child_count;
+
+    // Cell played to reach this node (-1 for the root) and whether that move ended the game
+    short move;
+    char result;
+};
+
+// The tree: two node pools (the second one receives the kept subtree when the root moves)
+struct MctsTreeState {
+    unique_ptr<MctsNode[]> nodes;
+    unique_ptr<MctsNode[]> spare;
+    int capacity;
+    atomic<int> used;
+
+    // Position and player to move at the root, and the board size and settings the tree was built for
+    Bitboard root_board;
+    char root_turn;
+    int size;
+    int win_length;
+    unsigned long long generation;
+    bool valid;
+};
+
+// Settings are copied at the start of each search, so they may change while other threads search
+static MctsSettings settings = {20000, 0, 1, 1.4, 1 << 20, 1};
+static mutex settings_mutex;
+
+// Bumped by every settings change; a tree built under older settings starts over
+static atomic<unsigned long long> settings_generation(0);
+
+static thread_local MctsStats last_stats = {0, 0, 0, 0, 0};
+
+// Tree of the calls without one, and their number on this thread (mixed into the playout seeds so every move
+// sees different random games)
+static thread_local MctsTree default_tree;
+static thread_local unsigned long long call_count = 0;
+
+// Threads of multi-threaded searches (one such search runs at a time; single-threaded ones take no lock)
+static mutex pool_mutex;
+static unique_ptr<ThreadPool> playout_pool;
+
+// Fast random numbers for the playouts (xorshift64*)
+static inline uint64_t next_random(uint64_t &state) {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 2685821657736338717ULL;
+}
+
+static inline char other(char turn) {
+    return (turn == 'X') ? 'O' : 'X';
+}
+
+// Reset a node to an unvisited leaf
+static void init_node(MctsNode &node, int move, char result) {
+    node.visits.store(0, memory_order_relaxed);
+    node.score.store(0, memory_order_relaxed);
+    node.virtual_loss.store(0, memory_order_relaxed);
+    node.state.store(NODE_LEAF, memory_order_relaxed);
+    node.first_child = 0;
+    node.child_count = 0;
+    node.move = move;
+    node.result = result;
+}
+
+// Allocate both pools the first time, or again if the capacity changed
+static void allocate_tree(MctsTreeState &tree, int max_nodes) {
+    if (tree.nodes == nullptr || tree.capacity != max_nodes) {
+        tree.capacity = max_nodes;
+        tree.nodes.reset(new MctsNode[tree.capacity]);
+        tree.spare.reset(new MctsNode[tree.capacity]);
+    }
+}
+
+// Start a new tree with the board at the root
+static void new_root(MctsTreeState &tree, const Bitboard &board, char turn, const MctsSettings &search,
+                     unsigned long long generation) {
+    allocate_tree(tree, search.max_nodes);
+    init_node(tree.nodes[0], -1, RESULT_NONE);
+    tree.used.store(1, memory_order_relaxed);
+    tree.root_board = board;
+    tree.root_turn = turn;
+    tree.size = geometry().size;
+    tree.win_length = geometry().win_length;
+    tree.generation = generation;
+    tree.valid = true;
+}
+
+// Copy the subtree below old_root into the spare pool (as its root), then swap the pools
+static void keep_subtree(MctsTreeState &tree, int old_root) {
+    MctsNode *from = tree.nodes.get();
+    MctsNode *to = tree.spare.get();
+
+    // Copy a node's fields (the children are copied separately)
+    auto copy_node = [](const MctsNode &source, MctsNode &target) {
+        init_node(target, source.move, source.result);
+        target.visits.store(source.visits.load(memory_order_relaxed), memory_order_relaxed);
+        target.score.store(source.score.load(memory_order_relaxed), memory_order_relaxed);
+    };
+
+    copy_node(from[old_root], to[0]);
+    to[0].move = -1;
+    int used = 1;
+
+    // Breadth first: each queued pair is (node in the old pool, its copy in the new pool)
+    vector<pair<int, int> > queue;
+    queue.push_back({old_root, 0});
+    for (size_t q = 0; q < queue.size(); q++) {
+        const MctsNode &source = from[queue[q].first];
+        MctsNode &target = to[queue[q].second];
+        if (source.state.load(memory_order_relaxed) != NODE_EXPANDED) {
+            continue;
+        }
+
+        target.first_child = used;
+        target.child_count = source.child_count;
+        target.state.store(NODE_EXPANDED, memory_order_relaxed);
+        for (int c = 0; c < source.child_count; c++) {
+            copy_node(from[source.first_child + c], to[used + c]);
+            queue.push_back({source.first_child + c, used + c});
+        }
+        used += source.child_count;
+    }
+
+    tree.nodes.swap(tree.spare);
+    tree.used.store(used, memory_order_relaxed);
+}
+
+// Move the root to the board if it can be reached from the current root through expanded nodes
+// (the AI's last move and the opponent's reply). Returns false if the tree can't be reused.
+static bool advance_root(MctsTreeState &tree, const Bitboard &board, char turn, const MctsSettings &search,
+                         unsigned long long generation) {
+    if (!tree.valid || tree.generation != generation || tree.capacity != search.max_nodes ||
+        tree.size != geometry().size || tree.win_length != geometry().win_length) {
+        return false;
+    }
+
+    // The new board must contain every piece of the old one
+    Bitboard added = {board.x & ~tree.root_board.x, board.o & ~tree.root_board.o};
+    if (!((tree.root_board.x & ~board.x) == BoardMask()) || !((tree.root_board.o & ~board.o) == BoardMask())) {
+        return false;
+    }
+
+    // Follow the added pieces down the tree, one move per level
+    int node = 0;
+    char mover = tree.root_turn;
+    while (any_cell(added.x) || any_cell(added.o)) {
+        const MctsNode &current = tree.nodes[node];
+        if (current.state.load(memory_order_relaxed) != NODE_EXPANDED) {
+            return false;
+        }
+
+        BoardMask &pieces = (mover == 'X') ? added.x : added.o;
+        int next = -1;
+        for (int c = 0; c < current.child_count; c++) {
+            if (has_cell(pieces, tree.nodes[current.first_child + c].move)) {
+                next = current.first_child + c;
+                break;
+            }
+        }
+        if (next < 0) {
+            return false;
+        }
+
+        remove_cell(pieces, tree.nodes[next].move);
+        node = next;
+        mover = other(mover);
+    }
+
+    if (mover != turn) {
+        return false;
+    }
+    if (node != 0) {
+        keep_subtree(tree, node);
+    }
+    tree.root_board = board;
+    tree.root_turn = turn;
+    return true;
+}
+
+// Create the children of a node (one per empty cell). Returns false if the pool is full.
+static bool expand(MctsTreeState &tree, MctsNode &node, const Bitboard &board, char turn) {
+    MoveList moves;
+    legal_moves(board, moves);
+
+    int first = tree.used.fetch_add(moves.count, memory_order_relaxed);
+    if (first + moves.count > tree.capacity) {
+        return false;
+    }
+
+    for (int i = 0; i < moves.count; i++) {
+        // Note whether the move ends the game, so playouts through the child don't need to check
+        int cell = moves.cells[i];
+        Bitboard child = board;
+        make_move(child, cell, turn);
+        char result = RESULT_NONE;
+        if (completes_line((turn == 'X') ? child.x : child.o, cell)) {
+            result = RESULT_WIN;
+        }
+        else if (moves.count == 1) {
+            result = RESULT_DRAW;
+        }
+        init_node(tree.nodes[first + i], cell, result);
+    }
+
+    node.first_child = first;
+    node.child_count = moves.count;
+    return true;
+}
+
+// Child with the highest UCT value. Virtual losses count as visits that scored nothing.
+static int select_child(const MctsTreeState &tree, const MctsNode &node, double exploration) {
+    int parent_visits = node.visits.load(memory_order_relaxed) + node.virtual_loss.load(memory_order_relaxed);
+    double log_parent = log((double)max(parent_visits, 1));
+
+    int best = -1;
+    double best_value = -1;
+    for (int c = 0; c < node.child_count; c++) {
+        const MctsNode &child = tree.nodes[node.first_child + c];
+        int visits = child.visits.load(memory_order_relaxed) + child.virtual_loss.load(memory_order_relaxed);
+
+        // Every move is tried once before any is tried twice
+        if (visits == 0) {
+            return node.first_child + c;
+        }
+
+        double win_rate = child.score.load(memory_order_relaxed) / (2.0 * visits);
+        double value = win_rate + exploration * sqrt(log_parent / visits);
+        if (value > best_value) {
+            best_value = value;
+            best = node.first_child + c;
+        }
+    }
+    return best;
+}
+
+// Play random moves to the end of the game. Returns the winner, or ' ' for a draw.
+static char playout(Bitboard board, char turn, uint64_t &random) {
+    MoveList moves;
+    legal_moves(board, moves);
+
+    while (moves.count > 0) {
+        // Take a random empty cell out of the list
+        int i = next_random(random) % moves.count;
+        int cell = moves.cells[i];
+        moves.cells[i] = moves.cells[--moves.count];
+
+        make_move(board, cell, turn);
+        if (completes_line((turn == 'X') ? board.x : board.o, cell)) {
+            return turn;
+        }
+        turn = other(turn);
+    }
+    return ' ';
+}
+
+// One playout: select down the tree, grow it by one level, play out, and count the result on the way back
+static void run_playout(MctsTreeState &tree, double exploration, uint64_t &random) {
+    int path[MAX_CELLS + 1];
+    char movers[MAX_CELLS + 1];
+    int depth = 0;
+
+    Bitboard board = tree.root_board;
+    char turn = tree.root_turn;
+    int node = 0;
+    char winner = ' ';
+    bool finished = false;
+
+    while (true) {
+        MctsNode &current = tree.nodes[node];
+
+        // The move into this node ended the game
+        if (current.result != RESULT_NONE) {
+            winner = (current.result == RESULT_WIN) ? other(turn) : ' ';
+            finished = true;
+            break;
+        }
+
+        // Grow the tree at nodes that already have a playout (the root always)
+        int state = current.state.load(memory_order_acquire);
+        if (state == NODE_LEAF && (node == 0 || current.visits.load(memory_order_relaxed) > 0)) {
+            int expected = NODE_LEAF;
+            if (current.state.compare_exchange_strong(expected, NODE_EXPANDING, memory_order_acq_rel)) {
+                if (expand(tree, current, board, turn)) {
+                    current.state.store(NODE_EXPANDED, memory_order_release);
+                    state = NODE_EXPANDED;
+                }
+                else {
+                    // Pool full: this node stays a leaf for good
+                    current.state.store(NODE_EXPANDING, memory_order_release);
+                }
+            }
+        }
+        if (state != NODE_EXPANDED) {
+            break;
+        }
+
+        // Go down, marking the child so other threads prefer other moves until this playout is counted
+        int child = select_child(tree, current, exploration);
+        tree.nodes[child].virtual_loss.fetch_add(1, memory_order_relaxed);
+        path[depth] = child;
+        movers[depth] = turn;
+        depth++;
+
+        make_move(board, tree.nodes[child].move, turn);
+        turn = other(turn);
+        node = child;
+    }
+
+    if (!finished) {
+        winner = playout(board, turn, random);
+    }
+
+    // Count the result for the player who made each move on the path
+    tree.nodes[0].visits.fetch_add(1, memory_order_relaxed);
+    for (int i = 0; i < depth; i++) {
+        MctsNode &step = tree.nodes[path[i]];
+        int points = (winner == ' ') ? 1 : (winner == movers[i]) ? 2 : 0;
+        step.score.fetch_add(points, memory_order_relaxed);
+        step.visits.fetch_add(1, memory_order_relaxed);
+        step.virtual_loss.fetch_sub(1, memory_order_relaxed);
+    }
+}
+
+MctsTree::MctsTree() : state(new MctsTreeState()) {
+    state->valid = false;
+}
+
+MctsTree::~MctsTree() {
+}
+
+void MctsTree::clear() {
+    state->valid = false;
+}
+
+int mcts_cell(const Bitboard &board, char AI) {
+    MctsSettings search = mcts_settings();
+    return mcts_cell(board, AI, search.playouts, search.time_ms);
+}
+
+int mcts_cell(const Bitboard &board, char AI, long long playout_budget, long long time_ms) {
+    call_count++;
+    uint64_t seed = ((uint64_t)mcts_settings().seed << 32) ^ (call_count * 0x9E3779B97F4A7C15ULL);
+    return mcts_cell(board, AI, playout_budget, time_ms, default_tree, seed);
+}
+
+int mcts_cell(const Bitboard &board, char AI, long long playout_budget, long long time_ms, MctsTree &owner,
+              uint64_t seed) {
+    long long start = now_ns();
+    MctsTreeState &tree = *owner.state;
+    MctsSettings search;
+    unsigned long long generation;
+    {
+        lock_guard<mutex> lock(settings_mutex);
+        search = settings;
+        generation = settings_generation.load(memory_order_relaxed);
+    }
+
+    // Keep the subtree of this position if the last search reached it, otherwise start over
+    if (!advance_root(tree, board, AI, search, generation)) {
+        new_root(tree, board, AI, search, generation);
+    }
+    long long reused = tree.nodes[0].visits.load(memory_order_relaxed);
+
+    // Split the playouts over the threads; each thread checks the clock every 64 playouts
+    int threads = max(1, search.threads);
+    long long deadline = (time_ms > 0) ? start + time_ms * 1000000LL : 0;
+    atomic<long long> done(0);
+
+    auto work = [&](int task) {
+        uint64_t random = seed ^ ((task + 1) * 0x9E3779B97F4A7C15ULL);
+        if (random == 0) {
+            random = 1;
+        }
+        next_random(random);
+        while (true) {
+            for (int i = 0; i < 64; i++) {
+                if (playout_budget > 0 && done.fetch_add(1, memory_order_relaxed) >= playout_budget) {
+                    return;
+                }
+                run_playout(tree, search.exploration, random);
+            }
+            if (deadline > 0 && now_ns() >= deadline) {
+                return;
+            }
+        }
+    };
+
+    if (threads > 1) {
+        lock_guard<mutex> lock(pool_mutex);
+        if (playout_pool == nullptr || playout_pool->size() != threads) {
+            playout_pool.reset(new ThreadPool(threads));
+        }
+        playout_pool->run(threads, work);
+    }
+    else {
+        work(0);
+    }
+    // Play a winning move right away, otherwise the move with the most playouts
+    const MctsNode &root = tree.nodes[0];
+    int best = -1;
+    int best_visits = -1;
+    for (int c = 0; c < root.child_count; c++) {
+        const MctsNode &child = tree.nodes[root.first_child + c];
+        if (child.result == RESULT_WIN) {
+            best = root.first_child + c;
+            break;
+        }
+        int visits = child.visits.load(memory_order_relaxed);
+        if (visits > best_visits) {
+            best_visits = visits;
+            best = root.first_child + c;
+        }
+    }
+
+    long long playouts = root.visits.load(memory_order_relaxed) - reused;
+    long long elapsed = now_ns() - start;
+    last_stats.playouts = playouts;
+    last_stats.reused_playouts = reused;
+    last_stats.tree_nodes = min(tree.used.load(memory_order_relaxed), tree.capacity);
+    last_stats.wall_ns = elapsed;
+    last_stats.playouts_per_second = (elapsed > 0) ? playouts * 1e9 / elapsed : 0;
+
+    return tree.nodes[best].move;
+}
+
+MctsSettings mcts_settings() {
+    lock_guard<mutex> lock(settings_mutex);
+    return settings;
+}
+
+void set_mcts_settings(const MctsSettings &new_settings) {
+    lock_guard<mutex> lock(settings_mutex);
+    settings = new_settings;
+
+    // A search needs some limit, and room for at least the root and its children
+    if (settings.playouts <= 0 && settings.time_ms <= 0) {
+        settings.playouts = 20000;
+    }
+    if (settings.max_nodes < MAX_CELLS + 1) {
+        settings.max_nodes = MAX_CELLS + 1;
+    }
+    settings_generation.fetch_add(1, memory_order_relaxed);
+}
+
+MctsStats last_mcts_stats() {
+    return last_stats;
+}
+
+void clear_mcts_tree() {
+    default_tree.clear();
+}
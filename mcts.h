@@ -0,0 +1,164 @@
+/*
+ * File: mcts.h
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * Monte Carlo Tree Search (UCT) engine, an alternative to minimax for boards too large to search exhaustively.
+ * Each playout walks down the tree picking children by the UCT formula, adds one level to the tree, then plays
+ * random moves to the end of the game and adds the result to every node on the way. The move played is the root
+ * child with the most playouts.
+ * The tree is kept between calls: when the next position is a descendant of the last root (the AI's move and the
+ * opponent's reply), that subtree becomes the new root and its playouts are reused. Every caller keeps its own tree
+ * (see MctsTree), so searches for different games don't re-root each other's trees and run at the same time.
+ * Playouts can run on several threads sharing the tree; a thread passing through a node adds a virtual loss to it
+ * until its playout is counted, so the other threads spread out over other moves.
+ */
+
+#ifndef _mcts_h
+#define _mcts_h
+
+#include "bitboard.h"
+#include <cstdint>
+#include <memory>
+
+using namespace std;
+
+// How much work a move gets and how the tree grows
+struct MctsSettings {
+    // Playouts per move (0 for no limit)
+    long long playouts;
+
+    // Time per move in milliseconds (0 for no limit); the search stops at whichever limit comes first
+    long long time_ms;
+
+    // Threads running playouts
+    int threads;
+
+    // UCT exploration constant (higher tries more moves, lower follows the best ones)
+    double exploration;
+
+    // Capacity of the tree in nodes (once full, playouts still run but the tree stops growing)
+    int max_nodes;
+
+    // Seed for the random playouts (the same seed and settings give the same moves on one thread)
+    unsigned seed;
+};
+
+// Statistics of the last mcts_cell() call
+struct MctsStats {
+    // Playouts run by this call, and playouts already in the reused subtree
+    long long playouts;
+    long long reused_playouts;
+
+    // Nodes in the tree when the call finished
+    long long tree_nodes;
+
+    // Wall time of the call in nanoseconds, and playouts per second
+    long long wall_ns;
+    double playouts_per_second;
+};
+
+// Nodes of a tree and the position at its root (defined in 'mcts.cpp')
+struct MctsTreeState;
+
+// Search tree of one caller, kept between its searches so the subtree of its next position can be reused.
+// A tree must not be searched by two calls at once. Its nodes are allocated by the first search.
+class MctsTree {
+public:
+    /*
+     * Function: MctsTree()
+     * Description: Creates an empty tree.
+     */
+    MctsTree();
+
+    /*
+     * Function: ~MctsTree()
+     * Description: Frees the nodes.
+     */
+    ~MctsTree();
+
+    MctsTree(const MctsTree &) = delete;
+    MctsTree &operator=(const MctsTree &) = delete;
+
+    /*
+     * Function: clear()
+     * Description: Forgets the kept tree, so the next search starts from scratch (the nodes stay allocated).
+     * Parameter(s):
+     * Returns: Void.
+     */
+    void clear();
+
+private:
+    unique_ptr<MctsTreeState> state;
+
+    friend int mcts_cell(const Bitboard &board, char AI, long long playout_budget, long long time_ms, MctsTree &tree,
+                         uint64_t seed);
+};
+
+/*
+ * Function: mcts_cell()
+ * Description: Chooses a move with Monte Carlo Tree Search within the current settings (see set_mcts_settings()).
+ *              Each thread keeps its own tree between these calls, so several threads may search at once.
+ * Parameter(s):
+ *     board: Bitboard of the position (not terminal; the AI must be the player to move).
+ *     AI: Char repersenting which player the AI is.
+ * Returns: Cell index of the chosen move.
+ */
+int mcts_cell(const Bitboard &board, char AI);
+
+/*
+ * Function: mcts_cell()
+ * Description: mcts_cell() with its own budget instead of the one in the settings (used to compare budgets).
+ * Parameter(s):
+ *     board: Bitboard of the position (not terminal; the AI must be the player to move).
+ *     AI: Char repersenting which player the AI is.
+ *     playout_budget: Playouts for this move (0 for no limit).
+ *     time_ms: Time for this move in milliseconds (0 for no limit; one of the two limits must be set).
+ * Returns: Cell index of the chosen move.
+ */
+int mcts_cell(const Bitboard &board, char AI, long long playout_budget, long long time_ms);
+
+/*
+ * Function: mcts_cell()
+ * Description: mcts_cell() with its own budget, on the caller's tree, with playouts drawn from the caller's seed.
+ *              With one thread, the same tree, seed and playout budget always give the same move.
+ * Parameter(s):
+ *     board: Bitboard of the position (not terminal; the AI must be the player to move).
+ *     AI: Char repersenting which player the AI is.
+ *     playout_budget: Playouts for this move (0 for no limit).
+ *     time_ms: Time for this move in milliseconds (0 for no limit; one of the two limits must be set).
+ *     tree: Tree to search, kept for the caller's next move.
+ *     seed: Seed of this move's playouts.
+ * Returns: Cell index of the chosen move.
+ */
+int mcts_cell(const Bitboard &board, char AI, long long playout_budget, long long time_ms, MctsTree &tree,
+              uint64_t seed);
+
+/*
+ * Function: mcts_settings() / set_mcts_settings()
+ * Description: Read or change the MCTS settings. The defaults are 20000 playouts, no time limit, 1 thread,
+ *              exploration 1.4, 2^20 nodes and seed 1. Changing them clears every tree.
+ */
+MctsSettings mcts_settings();
+void set_mcts_settings(const MctsSettings &settings);
+
+/*
+ * Function: last_mcts_stats()
+ * Description: Returns the statistics of the last mcts_cell() call on this thread.
+ * Parameter(s):
+ * Returns: MctsStats of the last call.
+ */
+MctsStats last_mcts_stats();
+
+/*
+ * Function: clear_mcts_tree()
+ * Description: Forgets the tree this thread keeps for mcts_cell(), so its next call starts from scratch.
+ * Parameter(s):
+ * Returns: Void.
+ */
+void clear_mcts_tree();
+
+#endif
@@ -0,0 +1,192 @@
+/*
+ * File: perfect_table.cpp
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * This file defines the functions declared in 'perfect_table.h'.
+ * Notes:
+ * Comments in this file are implementation level.
+ * More details regarding the purpose and use of each function can be found in 'perfect_table.h'.
+ */
+
+#include "perfect_table.h"
+#include "tictactoe_helper.h"
+#include <array>
+#include <cstdint>
+#include <iostream>
+
+// Each entry packs the best move in bits 0-3 (NO_MOVE if the game is over) and utility + 1 in bits 4-5
+const int NO_MOVE = 15;
+
+// Winning lines of the 3x3 grid as 9 bit masks, written out as constexpr so the compiler can solve the game
+constexpr uint16_t PERFECT_LINES[8] = {
+    0x007, 0x038, 0x1C0,
+    0x049, 0x092, 0x124,
+    0x111, 0x054
+};
+
+// Powers of 3, one per cell
+constexpr int POW3[9] = {1, 3, 9, 27, 81, 243, 729, 2187, 6561};
+
+// Solve every board by backward induction.
+// A child always has one more piece than its parent, so its index is always larger:
+// going from the last index down to 0 means every child is solved before its parents.
+constexpr array<uint8_t, PERFECT_TABLE_SIZE> solve_perfect_table() {
+    array<uint8_t, PERFECT_TABLE_SIZE> table {};
+
+    for (int index = PERFECT_TABLE_SIZE - 1; index >= 0; index--) {
+        // Decode the base 3 digits into masks
+        uint16_t x = 0;
+        uint16_t o = 0;
+        int digits = index;
+        for (int cell = 0; cell < 9; cell++) {
+            if (digits % 3 == 1) {
+                x |= (1 << cell);
+            }
+            else if (digits % 3 == 2) {
+                o |= (1 << cell);
+            }
+            digits /= 3;
+        }
+
+        // Terminal boards: a completed line or a full grid
+        int utility_ = 0;
+        for (int i = 0; i < 8; i++) {
+            if ((x & PERFECT_LINES[i]) == PERFECT_LINES[i]) {
+                utility_ = 1;
+            }
+            else if ((o & PERFECT_LINES[i]) == PERFECT_LINES[i]) {
+                utility_ = -1;
+            }
+        }
+        if (utility_ != 0 || (x | o) == 0x1FF) {
+            table[index] = (uint8_t)(((utility_ + 1) << 4) | NO_MOVE);
+            continue;
+        }
+
+        // Same rule as player(): X moves whenever it doesn't have more pieces than O
+        bool x_to_move = __builtin_popcount(x) <= __builtin_popcount(o);
+
+        // Same rule as minimax(): first cell in row-major order with a strictly better utility
+        int best_value = x_to_move ? -1000 : 1000;
+        int best_cell = NO_MOVE;
+        for (int cell = 0; cell < 9; cell++) {
+            if ((x | o) & (1 << cell)) {
+                continue;
+            }
+            int child = index + (x_to_move ? 1 : 2) * POW3[cell];
+            int value = (table[child] >> 4) - 1;
+            if ((x_to_move && value > best_value) || (!x_to_move && value < best_value)) {
+                best_value = value;
+                best_cell = cell;
+            }
+        }
+        table[index] = (uint8_t)(((best_value + 1) << 4) | best_cell);
+    }
+
+    return table;
+}
+
+// The solved table itself, computed entirely by the compiler
+static constexpr array<uint8_t, PERFECT_TABLE_SIZE> PERFECT_TABLE = solve_perfect_table();
+
+// Compile-time sanity checks: the empty board is a tie and minimax opens in the top-left corner
+static_assert((PERFECT_TABLE[0] >> 4) - 1 == 0, "empty board must be a tie");
+static_assert((PERFECT_TABLE[0] & 15) == 0, "first move must be (0, 0)");
+
+// Base 3 value of each possible mask, so an index is two lookups instead of a loop
+constexpr array<int, 512> solve_mask_digits() {
+    array<int, 512> digits {};
+    for (int mask = 0; mask < 512; mask++) {
+        for (int cell = 0; cell < 9; cell++) {
+            if (mask & (1 << cell)) {
+                digits[mask] += POW3[cell];
+            }
+        }
+    }
+    return digits;
+}
+
+static constexpr array<int, 512> MASK_DIGITS = solve_mask_digits();
+
+// X digits are 1 and O digits are 2
+int perfect_index(const Bitboard &board) {
+    return MASK_DIGITS[board.x.words[0] & 0x1FF] + 2 * MASK_DIGITS[board.o.words[0] & 0x1FF];
+}
+
+// Utility is stored plus 1 in bits 4-5
+int perfect_value(const Bitboard &board) {
+    return (PERFECT_TABLE[perfect_index(board)] >> 4) - 1;
+}
+
+// Best move is stored in bits 0-3
+int perfect_move(const Bitboard &board) {
+    int cell = PERFECT_TABLE[perfect_index(board)] & 15;
+    if (cell == NO_MOVE) {
+        return -1;
+    }
+    return cell;
+}
+
+// Depth first walk over every reachable position, comparing the table against the search.
+// Returns the number of mismatches found.
+static int verify_from(const Bitboard &board, vector<bool> &visited) {
+    int index = perfect_index(board);
+    if (visited[index]) {
+        return 0;
+    }
+    visited[index] = true;
+
+    if (terminal(board)) {
+        if (perfect_value(board) != utility(board) || perfect_move(board) != -1) {
+            cout << "Mismatch on terminal board " << index << endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    int mismatches = 0;
+    char turn = player(board);
+
+    // Compare the value with a full window search
+    int value = (turn == X) ? max_value(board, -1000, 1000) : min_value(board, -1000, 1000);
+    // Compare the move with the search behind minimax()
+    pair<int, int> move = minimax_search(to_vector(board), turn);
+    int cell = move.first * SIZE + move.second;
+
+    if (value != perfect_value(board) || cell != perfect_move(board)) {
+        cout << "Mismatch on board " << index << ": table " << perfect_value(board) << " at " << perfect_move(board)
+             << ", search " << value << " at " << cell << endl;
+        mismatches++;
+    }
+
+    BoardMask empty = empty_cells(board);
+    while (any_cell(empty)) {
+        mismatches += verify_from(result(board, pop_cell(empty)), visited);
+    }
+    return mismatches;
+}
+
+// Check every reachable position
+bool verify_perfect_table() {
+    // The table only describes the standard game
+    set_board_size(3, 3);
+    
+    vector<bool> visited(PERFECT_TABLE_SIZE, false);
+    Bitboard empty = {BoardMask(), BoardMask()};
+    int mismatches = verify_from(empty, visited);
+
+    // Count how many positions were checked
+    int checked = 0;
+    for (int i = 0; i < PERFECT_TABLE_SIZE; i++) {
+        if (visited[i]) {
+            checked++;
+        }
+    }
+
+    cout << "Checked " << checked << " reachable positions, " << mismatches << " mismatches." << endl;
+    return mismatches == 0;
+}
@@ -0,0 +1,59 @@
+/*
+ * File: perfect_table.h
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * Solved table of every 3x3 position (value and best move), generated at compile time with constexpr.
+ * minimax() answers from this table with a single lookup instead of searching.
+ * The table only applies to the standard game (3x3, 3 in a row); the functions below assume the board is 3x3.
+ */
+
+#ifndef _perfect_table_h
+#define _perfect_table_h
+
+#include "bitboard.h"
+
+// Number of entries in the table (every board with each cell ' ', X or O, so 3^9)
+const int PERFECT_TABLE_SIZE = 19683;
+
+/*
+ * Function: perfect_index()
+ * Description: Returns the index of a board in the table (base 3 number with one digit per cell: 0 empty, 1 X, 2 O).
+ * Parameter(s):
+ *     board: Bitboard repersenting the board.
+ * Returns: Index of the board in the table.
+ */
+int perfect_index(const Bitboard &board);
+
+/*
+ * Function: perfect_value()
+ * Description: Looks up the utility of a board given optimal play from both players.
+ * Parameter(s):
+ *     board: Bitboard repersenting the board.
+ * Returns: 1 if X wins, -1 if O wins, 0 if tied.
+ */
+int perfect_value(const Bitboard &board);
+
+/*
+ * Function: perfect_move()
+ * Description: Looks up the optimal move for the player to move. This is the same move minimax() would find by
+ *              searching: the first cell in row-major order with the best utility.
+ * Parameter(s):
+ *     board: Bitboard repersenting the board.
+ * Returns: Cell index (row * SIZE + col) of the optimal move, -1 if the game is over.
+ */
+int perfect_move(const Bitboard &board);
+
+/*
+ * Function: verify_perfect_table()
+ * Description: Self-check that compares the table against the minimax search for every reachable position
+ *              and prints any mismatch. Switches the board size to 3x3 first (see set_board_size()).
+ * Parameter(s):
+ * Returns: Boolean value; true if every position matches, false otherwise.
+ */
+bool verify_perfect_table();
+
+#endif
@@ -0,0 +1,141 @@
+/*
+ * File: ponder.cpp
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * This file defines the functions declared in 'ponder.h'.
+ * Notes:
+ * Comments in this file are implementation level.
+ * More details regarding the purpose and use of each function can be found in 'ponder.h'.
+ */
+
+#include "ponder.h"
+#include "anytime.h"
+
+// Whether run_game() ponders
+static bool pondering_enabled = true;
+
+Ponderer::Ponderer() : stopping(false), ai('O'), level('I'), searching(-1), finished(true) {
+    root = {BoardMask(), BoardMask()};
+}
+
+Ponderer::~Ponderer() {
+    stop();
+}
+
+void Ponderer::start(const Bitboard &board, char AI, char difficulty) {
+    stop();
+
+    // Fresh state, then the thread
+    root = board;
+    ai = AI;
+    level = difficulty;
+    for (int i = 0; i < MAX_CELLS; i++) {
+        replies[i] = -1;
+    }
+    searching = -1;
+    finished = false;
+    stopping.store(false);
+    worker = thread(&Ponderer::work, this);
+}
+
+void Ponderer::work() {
+    // The searches of this thread watch the stop flag
+    set_search_stop(&stopping);
+
+    // Every empty cell in the geometry's move order, or on boards too large to search to the end, where each reply
+    // takes a whole move budget, the human's likely moves first
+    char human = (ai == X) ? O : X;
+    bool large = anytime_board();
+    MoveList order;
+    if (large) {
+        likely_moves(root, human, order);
+    }
+    else {
+        order.count = 0;
+        for (int cell : geometry().move_order) {
+            if (has_cell(empty_cells(root), cell)) {
+                order.cells[order.count++] = cell;
+            }
+        }
+    }
+
+    for (int i = 0; i < order.count && !stopping.load(); i++) {
+        int move = order.cells[i];
+
+        // Nothing to reply to once the human's move ends the game
+        Bitboard child = root;
+        make_move(child, move, human);
+        if (terminal(child)) {
+            continue;
+        }
+
+        {
+            lock_guard<mutex> lock(state_mutex);
+            searching = move;
+        }
+        int reply = large ? large_board_cell(child, ai, level) : minimax_cell(child, ai);
+
+        // A stopped search's move is meaningless
+        lock_guard<mutex> lock(state_mutex);
+        searching = -1;
+        if (stopping.load()) {
+            break;
+        }
+        replies[move] = reply;
+        reply_stats[move] = last_search_stats();
+        reply_ready.notify_all();
+    }
+
+    lock_guard<mutex> lock(state_mutex);
+    finished = true;
+    reply_ready.notify_all();
+}
+
+bool Ponderer::take(const Bitboard &board, int &cell, SearchStats &stats) {
+    if (!worker.joinable()) {
+        return false;
+    }
+
+    // The human's move is the one new piece (anything else isn't a position this ponderer looked at)
+    BoardMask added = (board.x | board.o) & ~(root.x | root.o);
+    bool one_move = count_cells(added) == 1 && ((board.x & root.x) == root.x) && ((board.o & root.o) == root.o);
+    if (!one_move) {
+        stop();
+        return false;
+    }
+    int move = pop_cell(added);
+
+    // Wait only for the reply being searched right now; other unfinished replies are searched from scratch
+    bool found;
+    {
+        unique_lock<mutex> lock(state_mutex);
+        reply_ready.wait(lock, [&] { return replies[move] >= 0 || searching != move || finished; });
+        found = replies[move] >= 0;
+        if (found) {
+            cell = replies[move];
+            stats = reply_stats[move];
+        }
+    }
+
+    stop();
+    return found;
+}
+
+void Ponderer::stop() {
+    if (worker.joinable()) {
+        stopping.store(true);
+        worker.join();
+    }
+}
+
+void set_pondering(bool enabled) {
+    pondering_enabled = enabled;
+}
+
+bool pondering() {
+    return pondering_enabled;
+}
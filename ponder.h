@@ -0,0 +1,111 @@
+/*
+ * File: ponder.h
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * Pondering: the AI searches while the human is thinking.
+ * When the human's turn begins, a background thread searches the AI's reply to every move the human could make
+ * (most promising moves first, see Geometry::move_order). When the human moves, the reply to that move is
+ * either ready, in progress (then it is awaited, it has a head start), or not started (then the AI searches as
+ * usual, with a transposition table already warmed by the pondering). Every other search is stopped right away
+ * and leaves nothing half-finished in the transposition table.
+ * On boards too large to search to the end, each reply is the level's budgeted search (see large_board_cell()), so
+ * only a few replies fit in the human's turn: the human's likely moves go first (see likely_moves() in
+ * 'anytime.h').
+ * Only the minimax backend ponders; Monte Carlo Tree Search keeps its tree between moves instead.
+ */
+
+#ifndef _ponder_h
+#define _ponder_h
+
+#include "tictactoe_helper.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+class Ponderer {
+public:
+    /*
+     * Function: Ponderer()
+     * Description: Creates an idle ponderer (no thread runs until start()).
+     */
+    Ponderer();
+
+    /*
+     * Function: ~Ponderer()
+     * Description: Stops the background search, if any.
+     */
+    ~Ponderer();
+
+    /*
+     * Function: start()
+     * Description: Starts searching the AI's replies to every move from board in the background.
+     *              Stops whatever was being pondered before.
+     * Parameter(s):
+     *     board: Bitboard of the position, with the human to move.
+     *     AI: Char repersenting which player the AI is.
+     *     difficulty: The AI's difficulty level (its depth and threat search on large boards).
+     * Returns: Void.
+     */
+    void start(const Bitboard &board, char AI, char difficulty);
+
+    /*
+     * Function: take()
+     * Description: Returns the pondered reply for board, which must be the pondered position plus the human's move.
+     *              Waits if that reply is being searched right now. Stops the background search.
+     * Parameter(s):
+     *     board: Bitboard of the position after the human's move.
+     *     cell: Set to the AI's reply if it was pondered.
+     *     stats: Set to the statistics of the pondered search.
+     * Returns: Boolean value; true if the reply was pondered, false if the AI has to search.
+     */
+    bool take(const Bitboard &board, int &cell, SearchStats &stats);
+
+    /*
+     * Function: stop()
+     * Description: Stops the background search and waits for its thread to end. Does nothing if idle.
+     * Parameter(s):
+     * Returns: Void.
+     */
+    void stop();
+
+private:
+    // Loop run by the background thread
+    void work();
+
+    thread worker;
+
+    // Watched by the background thread's searches (see set_search_stop())
+    atomic<bool> stopping;
+
+    // Position being pondered, and the AI's side and level
+    Bitboard root;
+    char ai;
+    char level;
+
+    // Protects everything below
+    mutex state_mutex;
+    condition_variable reply_ready;
+
+    // Reply and statistics for each human move (reply -1 if not searched yet), the move being searched (-1 if
+    // none), and whether the thread has finished
+    int replies[MAX_CELLS];
+    SearchStats reply_stats[MAX_CELLS];
+    int searching;
+    bool finished;
+};
+
+/*
+ * Function: set_pondering() / pondering()
+ * Description: Turn pondering in run_game() on or off, and check whether it is on (on by default).
+ */
+void set_pondering(bool enabled);
+bool pondering();
+
+#endif
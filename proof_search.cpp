@@ -0,0 +1,480 @@
+/*
+ * File: proof_search.cpp
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * This file defines the functions declared in 'proof_search.h'.
+ * Notes:
+ * Comments in this file are implementation level.
+ * More details regarding the purpose and use of each function can be found in 'proof_search.h'.
+ */
+
+#include "proof_search.h"
+#include "tictactoe_helper.h"
+#include "histogram.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+// Proof or disproof number of a node that can't be proven (or disproven); sums stop here
+const uint32_t PROOF_INFINITY = 1u << 30;
+
+// Index of no node
+const uint32_t NO_NODE = 0xFFFFFFFF;
+
+// Nodes per chunk of the pool (children of a node never straddle two chunks)
+const int CHUNK_BITS = 16;
+const uint32_t CHUNK_NODES = 1u << CHUNK_BITS;
+
+/*
+ * Class: ProofPool
+ * Description: Nodes in chunks of CHUNK_NODES. Chunks are only ever added, so indices stay valid; reset() reuses
+ *              them for the next tree.
+ */
+class ProofPool {
+public:
+    ProofPool() : chunk(0), offset(0), limit(0) {
+    }
+
+    // Forget every node and allow up to max_nodes
+    void reset(long long max_nodes) {
+        chunk = 0;
+        offset = 0;
+        limit = max_nodes;
+    }
+
+    // count nodes next to each other, or NO_NODE if the limit is reached
+    uint32_t allocate(int count) {
+        if ((long long)used() + count > limit) {
+            return NO_NODE;
+        }
+        if (offset + count > CHUNK_NODES) {
+            chunk++;
+            offset = 0;
+        }
+        if (chunk == chunks.size()) {
+            chunks.emplace_back(new ProofNode[CHUNK_NODES]);
+        }
+        uint32_t index = (chunk << CHUNK_BITS) | offset;
+        offset += count;
+        return index;
+    }
+
+    ProofNode &operator[](uint32_t index) {
+        return chunks[index >> CHUNK_BITS][index & (CHUNK_NODES - 1)];
+    }
+
+    // Nodes handed out since the last reset (counting the unused ends of earlier chunks)
+    size_t used() const {
+        return ((size_t)chunk << CHUNK_BITS) + offset;
+    }
+
+    size_t bytes() const {
+        return chunks.size() * CHUNK_NODES * sizeof(ProofNode);
+    }
+
+private:
+    vector<unique_ptr<ProofNode[]> > chunks;
+    uint32_t chunk;
+    uint32_t offset;
+    long long limit;
+};
+
+// Every thread has its own pool, so several threads can search at once
+static thread_local ProofPool pool;
+
+// Statistics of the last search on this thread
+static thread_local ProofStats last_stats = {PROOF_UNKNOWN, 0, 0, 0, 0, sizeof(ProofNode), 0};
+
+// Whether ai_cell() looks for forced wins on large boards
+static bool threats_enabled = true;
+
+static inline char other(char turn) {
+    return (turn == X) ? O : X;
+}
+
+static inline uint32_t saturating_add(uint32_t a, uint32_t b) {
+    return min(a + b, PROOF_INFINITY);
+}
+
+// Cells where the team completes a line (the last empty cell of a line holding only its pieces), as a mask
+static BoardMask winning_cells(const Position &position, char team) {
+    const Geometry &g = geometry();
+    const uint8_t *own = (team == X) ? position.x_line : position.o_line;
+    const uint8_t *theirs = (team == X) ? position.o_line : position.x_line;
+    BoardMask occupied = position.board.x | position.board.o;
+    BoardMask cells = BoardMask();
+    for (size_t l = 0; l < g.lines.size(); l++) {
+        if (own[l] == g.win_length - 1 && theirs[l] == 0) {
+            cells = cells | (g.lines[l] & ~occupied);
+        }
+    }
+    return cells;
+}
+
+// Cells where the team makes a four (the empty cells of lines holding only its pieces, two short of complete)
+static BoardMask four_cells(const Position &position, char team) {
+    const Geometry &g = geometry();
+    BoardMask cells = BoardMask();
+    if (g.win_length < 2) {
+        return cells;
+    }
+    const uint8_t *own = (team == X) ? position.x_line : position.o_line;
+    const uint8_t *theirs = (team == X) ? position.o_line : position.x_line;
+    BoardMask occupied = position.board.x | position.board.o;
+    for (size_t l = 0; l < g.lines.size(); l++) {
+        if (own[l] == g.win_length - 2 && theirs[l] == 0) {
+            cells = cells | (g.lines[l] & ~occupied);
+        }
+    }
+    return cells;
+}
+
+// Threats of a position for the player to move, from one pass over the lines: cells where they win, cells where
+// the other player wins, and cells where they make a four
+struct Threats {
+    BoardMask wins;
+    BoardMask blocks;
+    BoardMask fours;
+};
+
+static Threats find_threats(const Position &position, char turn) {
+    const Geometry &g = geometry();
+    const uint8_t *own = (turn == X) ? position.x_line : position.o_line;
+    const uint8_t *theirs = (turn == X) ? position.o_line : position.x_line;
+    BoardMask free = ~(position.board.x | position.board.o);
+    Threats threats = {BoardMask(), BoardMask(), BoardMask()};
+    int lines = g.lines.size();
+    for (int l = 0; l < lines; l++) {
+        if (theirs[l] == 0) {
+            if (own[l] == g.win_length - 1) {
+                threats.wins = threats.wins | (g.lines[l] & free);
+            }
+            else if (own[l] == g.win_length - 2 && g.win_length >= 2) {
+                threats.fours = threats.fours | (g.lines[l] & free);
+            }
+        }
+        else if (own[l] == 0 && theirs[l] == g.win_length - 1) {
+            threats.blocks = threats.blocks | (g.lines[l] & free);
+        }
+    }
+    return threats;
+}
+
+// Cells where the team would complete a line after playing the cell (from the lines through it only)
+static BoardMask wins_after(const Position &position, int cell, char team) {
+    const Geometry &g = geometry();
+    const uint8_t *own = (team == X) ? position.x_line : position.o_line;
+    const uint8_t *theirs = (team == X) ? position.o_line : position.x_line;
+    BoardMask free = ~(position.board.x | position.board.o);
+    remove_cell(free, cell);
+    BoardMask cells = BoardMask();
+    const vector<int> &lines = g.cell_lines[cell];
+    for (size_t i = 0; i < lines.size(); i++) {
+        if (own[lines[i]] == g.win_length - 2 && theirs[lines[i]] == 0) {
+            cells = cells | (g.lines[lines[i]] & free);
+        }
+    }
+    return cells;
+}
+
+// Settle a node as proven or disproven
+static inline void settle(ProofNode &node, bool proven) {
+    node.proof = proven ? 0 : PROOF_INFINITY;
+    node.disproof = proven ? PROOF_INFINITY : 0;
+    node.expanded = 1;
+}
+
+// Make the children of a leaf: the position is the leaf's, and turn is the player to move there.
+// Returns false if the pool is full (the leaf stays a leaf).
+static bool expand(uint32_t index, Position &position, char turn, char attacker) {
+    ProofNode &node = pool[index];
+    if (position.empty == 0) {
+        settle(node, false);
+        return true;
+    }
+
+    MoveList moves;
+    moves.count = 0;
+    Threats threats = find_threats(position, turn);
+    if (turn == attacker) {
+        // A win right away ends the search; a four of the defender's has to be blocked with a four
+        if (any_cell(threats.wins)) {
+            settle(node, true);
+            return true;
+        }
+        BoardMask fours = threats.fours;
+        if (count_cells(threats.blocks) > 1) {
+            settle(node, false);
+            return true;
+        }
+        if (any_cell(threats.blocks)) {
+            fours = fours & threats.blocks;
+        }
+        while (any_cell(fours)) {
+            moves.cells[moves.count++] = pop_cell(fours);
+        }
+    }
+    else {
+        // The defender wins first if they can; otherwise every four of the attacker's has to be blocked
+        if (any_cell(threats.wins)) {
+            settle(node, false);
+            return true;
+        }
+        if (count_cells(threats.blocks) > 1) {
+            settle(node, true);
+            return true;
+        }
+        if (any_cell(threats.blocks)) {
+            moves.cells[moves.count++] = pop_cell(threats.blocks);
+        }
+        else {
+            // Only reached if the attacker's last move wasn't a four, which the moves above never allow
+            legal_moves(position.board, moves);
+        }
+    }
+
+    if (moves.count == 0) {
+        settle(node, turn != attacker);
+        return true;
+    }
+
+    uint32_t first = pool.allocate(moves.count);
+    if (first == NO_NODE) {
+        return false;
+    }
+    ProofNode &parent = pool[index];
+    parent.first_child = first;
+    parent.child_count = moves.count;
+    parent.expanded = 1;
+    for (int i = 0; i < moves.count; i++) {
+        ProofNode &child = pool[first + i];
+        child.proof = 1;
+        child.disproof = 1;
+        child.parent = index;
+        child.first_child = NO_NODE;
+        child.child_count = 0;
+        child.cell = moves.cells[i];
+        child.expanded = 0;
+
+        // A four that leaves two cells to win at can't be blocked, so it is proven without going deeper. Without
+        // this, the chains of single replies below every four look as easy as the win and are searched first.
+        if (turn == attacker && count_cells(wins_after(position, child.cell, turn)) > 1) {
+            settle(child, true);
+        }
+    }
+    return true;
+}
+
+// Recompute an expanded node's numbers from its children. The attacker needs one proven child, the defender needs
+// every child proven.
+static void update(uint32_t index, bool attacker_to_move) {
+    ProofNode &node = pool[index];
+    if (node.child_count == 0) {
+        return;
+    }
+    uint32_t proof = attacker_to_move ? PROOF_INFINITY : 0;
+    uint32_t disproof = attacker_to_move ? 0 : PROOF_INFINITY;
+    for (int i = 0; i < node.child_count; i++) {
+        const ProofNode &child = pool[node.first_child + i];
+        if (attacker_to_move) {
+            proof = min(proof, child.proof);
+            disproof = saturating_add(disproof, child.disproof);
+        }
+        else {
+            proof = saturating_add(proof, child.proof);
+            disproof = min(disproof, child.disproof);
+        }
+    }
+    node.proof = proof;
+    node.disproof = disproof;
+}
+
+// Child the search goes into: the easiest to prove where the attacker moves, the easiest to disprove otherwise
+static uint32_t most_proving_child(uint32_t index, bool attacker_to_move) {
+    const ProofNode &node = pool[index];
+    uint32_t best = node.first_child;
+    for (int i = 1; i < node.child_count; i++) {
+        const ProofNode &child = pool[node.first_child + i];
+        const ProofNode &current = pool[best];
+        if (attacker_to_move ? child.proof < current.proof : child.disproof < current.disproof) {
+            best = node.first_child + i;
+        }
+    }
+    return best;
+}
+
+ProofResult prove_win(const Bitboard &board, char attacker, long long time_ms, long long max_nodes, int &best_cell) {
+    long long start = now_ns();
+    long long deadline = (time_ms > 0) ? start + time_ms * 1000000 : 0;
+    pool.reset(max_nodes > 0 ? max_nodes : PROOF_MAX_NODES);
+    best_cell = -1;
+
+    uint32_t root = pool.allocate(1);
+    ProofNode &first = pool[root];
+    first.proof = 1;
+    first.disproof = 1;
+    first.parent = NO_NODE;
+    first.first_child = NO_NODE;
+    first.child_count = 0;
+    first.cell = 0;
+    first.expanded = 0;
+
+    Position position = to_position(board);
+    long long expanded = 0;
+    bool out_of_budget = false;
+    while (pool[root].proof != 0 && pool[root].disproof != 0) {
+        if ((expanded & 15) == 0 && (search_stop_requested() || (deadline > 0 && now_ns() >= deadline))) {
+            out_of_budget = true;
+            break;
+        }
+
+        // Walk down to the most proving leaf, playing its moves
+        uint32_t node = root;
+        char turn = attacker;
+        while (pool[node].expanded) {
+            node = most_proving_child(node, turn == attacker);
+            make_move(position, pool[node].cell, turn);
+            turn = other(turn);
+        }
+
+        if (!expand(node, position, turn, attacker)) {
+            out_of_budget = true;
+        }
+        expanded++;
+
+        // Back up the numbers to the root, taking the moves back
+        while (true) {
+            update(node, turn == attacker);
+            if (node == root) {
+                break;
+            }
+            turn = other(turn);
+            unmake_move(position, pool[node].cell, turn);
+            node = pool[node].parent;
+        }
+        if (out_of_budget) {
+            break;
+        }
+    }
+
+    ProofResult result = PROOF_UNKNOWN;
+    if (pool[root].proof == 0) {
+        result = PROOF_WIN;
+
+        // A root proven without children is a win on the first move
+        if (pool[root].child_count == 0) {
+            BoardMask wins = winning_cells(position, attacker);
+            best_cell = pop_cell(wins);
+        }
+        for (int i = 0; i < pool[root].child_count; i++) {
+            if (pool[pool[root].first_child + i].proof == 0) {
+                best_cell = pool[pool[root].first_child + i].cell;
+                break;
+            }
+        }
+    }
+    else if (pool[root].disproof == 0) {
+        result = PROOF_NO_WIN;
+    }
+
+    long long elapsed = now_ns() - start;
+    last_stats.result = result;
+    last_stats.nodes = pool.used();
+    last_stats.expanded = expanded;
+    last_stats.wall_ns = elapsed;
+    last_stats.nodes_per_second = (elapsed > 0) ? pool.used() * 1e9 / elapsed : 0;
+    last_stats.node_bytes = sizeof(ProofNode);
+    last_stats.pool_bytes = pool.bytes();
+    return result;
+}
+
+// Add the cells of every move in the proof below a proven node (the attacker's winning moves and every reply)
+static void proof_cells(uint32_t index, bool attacker_to_move, BoardMask &cells) {
+    const ProofNode &node = pool[index];
+    for (int i = 0; i < node.child_count; i++) {
+        uint32_t child = node.first_child + i;
+        if (attacker_to_move && pool[child].proof != 0) {
+            continue;
+        }
+        add_cell(cells, pool[child].cell);
+        proof_cells(child, !attacker_to_move, cells);
+        if (attacker_to_move) {
+            break;
+        }
+    }
+}
+
+int threat_cell(const Bitboard &board, char AI, long long time_ms, long long max_nodes) {
+    long long start = now_ns();
+
+    // A third of the time and nodes for each side's search, the rest for trying defenses
+    long long search_ms = (time_ms > 0) ? max(1LL, time_ms / 3) : 0;
+    long long search_nodes = (max_nodes > 0) ? max(1LL, max_nodes / 3) : 0;
+    long long nodes_left = max_nodes;
+    int cell;
+    if (prove_win(board, AI, search_ms, search_nodes, cell) == PROOF_WIN) {
+        return cell;
+    }
+    nodes_left -= last_stats.nodes;
+
+    char opponent = other(AI);
+    if (prove_win(board, opponent, search_ms, search_nodes, cell) != PROOF_WIN) {
+        return -1;
+    }
+    nodes_left -= last_stats.nodes;
+
+    // Defenses to try: the opponent's first move, every other cell of their proof, the ends of every line they
+    // are two short of, and every four of the AI's (which the opponent has to answer first)
+    Position position = to_position(board);
+    BoardMask occupied = board.x | board.o;
+    BoardMask cells = BoardMask();
+    proof_cells(0, true, cells);
+    cells = cells | four_cells(position, opponent) | winning_cells(position, opponent) | four_cells(position, AI);
+    cells = cells & ~occupied & geometry().full;
+    remove_cell(cells, cell);
+
+    vector<int> candidates = {cell};
+    while (any_cell(cells)) {
+        candidates.push_back(pop_cell(cells));
+    }
+
+    // The first move after which the opponent has no win by fours, or else one where their search ran out
+    int unknown = -1;
+    for (size_t i = 0; i < candidates.size(); i++) {
+        long long left = (time_ms > 0) ? time_ms * 1000000 - (now_ns() - start) : 0;
+        if ((time_ms > 0 && left <= 0) || (max_nodes > 0 && nodes_left <= 0)) {
+            break;
+        }
+        long long remaining = candidates.size() - i;
+        long long each_ms = (time_ms > 0) ? max(1LL, left / 1000000 / remaining) : 0;
+        long long each_nodes = (max_nodes > 0) ? max(1LL, nodes_left / remaining) : 0;
+        Bitboard after = board;
+        make_move(after, candidates[i], AI);
+        int reply;
+        ProofResult answer = prove_win(after, opponent, each_ms, each_nodes, reply);
+        nodes_left -= last_stats.nodes;
+        if (answer == PROOF_NO_WIN) {
+            return candidates[i];
+        }
+        if (answer == PROOF_UNKNOWN && unknown < 0) {
+            unknown = candidates[i];
+        }
+    }
+    return unknown;
+}
+
+bool threat_search() {
+    return threats_enabled;
+}
+
+void set_threat_search(bool enabled) {
+    threats_enabled = enabled;
+}
+
+ProofStats last_proof_stats() {
+    return last_stats;
+}
@@ -0,0 +1,122 @@
+/*
+ * File: proof_search.h
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * Proof-number search over threat sequences, for large k-in-a-row boards where full-width search can't see far
+ * enough. On large boards a game is usually decided by a chain of threats the defender must answer one at a time.
+ * The search proves that the attacker wins with a victory by continuous fours: every attacking move leaves a line
+ * one piece short of complete (a four), so the defender has exactly one reply, and the chain ends in a move that
+ * leaves two such lines the defender can't both block.
+ * The attacker may also answer a four of the defender's with a block, but only if the block is a four itself.
+ * A proof is sound: every defender reply is searched. A disproof only means no such chain exists; the attacker
+ * might still win with quieter moves.
+ * The tree lives in a pool of fixed-size nodes allocated in large chunks, kept between searches, so a search
+ * allocates nothing once the pool has grown.
+ */
+
+#ifndef _proof_search_h
+#define _proof_search_h
+
+#include "bitboard.h"
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+// Default limit on the nodes of one proof tree (the pool grows to this in chunks as needed)
+const long long PROOF_MAX_NODES = 1 << 21;
+
+// Result of a proof search
+enum ProofResult {
+    // The attacker wins by a chain of fours
+    PROOF_WIN,
+
+    // No chain of fours wins for the attacker
+    PROOF_NO_WIN,
+
+    // The budget ran out first
+    PROOF_UNKNOWN
+};
+
+// One node of the proof tree (the children of a node are next to each other in the pool)
+struct ProofNode {
+    // Leaves below this node still to prove (0 if proven) or disprove (0 if disproven)
+    uint32_t proof;
+    uint32_t disproof;
+
+    // Index of the parent and of the first child in the pool, and the number of children
+    uint32_t parent;
+    uint32_t first_child;
+    uint16_t child_count;
+
+    // Cell of the move that leads to this node, and whether its children were made
+    uint8_t cell;
+    uint8_t expanded;
+};
+
+// Statistics of the last prove_win() call
+struct ProofStats {
+    ProofResult result;
+
+    // Nodes in the proof tree, nodes expanded, and wall time of the call in nanoseconds
+    long long nodes;
+    long long expanded;
+    long long wall_ns;
+
+    // Nodes made per second, bytes per node, and bytes the pool holds
+    double nodes_per_second;
+    size_t node_bytes;
+    size_t pool_bytes;
+};
+
+/*
+ * Function: prove_win()
+ * Description: Searches for a chain of fours that wins for the attacker, who moves first whatever the piece counts
+ *              say (so it also answers "what if the other player passed?"). Works on every board size with
+ *              at most 256 cells and a win length of at least 2.
+ * Parameter(s):
+ *     board: Bitboard of the position (not terminal).
+ *     attacker: Char repersenting the player trying to win, who moves first.
+ *     time_ms: Time for the search in milliseconds (0 for no limit).
+ *     max_nodes: Largest proof tree (0 for PROOF_MAX_NODES).
+ *     best_cell: Set to the first move of the proof if the attacker wins, -1 otherwise.
+ * Returns: PROOF_WIN, PROOF_NO_WIN, or PROOF_UNKNOWN if the time or nodes ran out or the search was told to stop
+ *          (see set_search_stop() in 'tictactoe_helper.h').
+ */
+ProofResult prove_win(const Bitboard &board, char attacker, long long time_ms, long long max_nodes, int &best_cell);
+
+/*
+ * Function: threat_cell()
+ * Description: Finds the move that forced wins call for: the first move of the AI's own win if prove_win() finds
+ *              one, otherwise, if the opponent would win by fours were it their turn, a move after which they no
+ *              longer do (a block, or a four that forces them to answer).
+ * Parameter(s):
+ *     board: Bitboard of the position (not terminal; the AI must be the player to move).
+ *     AI: Char repersenting which player the AI is.
+ *     time_ms: Time for every search together in milliseconds (0 for no limit).
+ *     max_nodes: Proof tree nodes for every search together (0 for up to PROOF_MAX_NODES in each search).
+ * Returns: Cell index of the move, or -1 if neither side has a win by fours (or no move stops the opponent's).
+ */
+int threat_cell(const Bitboard &board, char AI, long long time_ms, long long max_nodes);
+
+/*
+ * Function: threat_search() / set_threat_search()
+ * Description: Read or change whether minimax levels on large boards run threat_cell() before the anytime search
+ *              (see ai_cell() in 'tictactoe_helper.h'). On by default.
+ */
+bool threat_search();
+void set_threat_search(bool enabled);
+
+/*
+ * Function: last_proof_stats()
+ * Description: Returns the statistics of the last prove_win() call on this thread.
+ * Parameter(s):
+ * Returns: ProofStats of the last call.
+ */
+ProofStats last_proof_stats();
+
+#endif
@@ -0,0 +1,165 @@
+/*
+ * File: renderer.cpp
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * This file defines the functions declared in 'renderer.h'.
+ * Notes:
+ * Comments in this file are implementation level.
+ * More details regarding the purpose and use of each function can be found in 'renderer.h'.
+ */
+
+#include "renderer.h"
+#include <iostream>
+
+// Escape that switches to each style (index is the style)
+static const char *STYLE_CODES[] = {"\033[0m", "\033[41m", "\033[42m"};
+
+Renderer::Renderer(int fd) {
+    this->fd = fd;
+    first_frame = true;
+    cursor_row = 0;
+    cursor_column = 0;
+}
+
+void Renderer::begin_frame() {
+    // Keep the rows' memory for the next frame
+    for (size_t r = 0; r < back.size(); r++) {
+        back[r].clear();
+    }
+    cursor_row = 0;
+    cursor_column = 0;
+}
+
+void Renderer::text(const string &text, unsigned char style) {
+    if (back.size() <= (size_t)cursor_row) {
+        back.resize(cursor_row + 1);
+    }
+    for (size_t i = 0; i < text.size(); i++) {
+        back[cursor_row].push_back({text[i], style});
+    }
+    cursor_column = back[cursor_row].size();
+}
+
+void Renderer::newline() {
+    cursor_row++;
+    cursor_column = 0;
+    if (back.size() <= (size_t)cursor_row) {
+        back.resize(cursor_row + 1);
+    }
+}
+
+// Cursor movement (rows and columns on the terminal start at 1). at_row/at_column track where the terminal
+// cursor is (-1 if unknown), so no escape is sent when it is already in place.
+static void move_to(string &output, int row, int column, int &at_row, int &at_column) {
+    if (row == at_row && column == at_column) {
+        return;
+    }
+    at_row = row;
+    at_column = column;
+    output += "\033[";
+    output += to_string(row + 1);
+    output += ';';
+    output += to_string(column + 1);
+    output += 'H';
+}
+
+size_t Renderer::present() {
+    output.clear();
+    
+    // The first frame starts from a cleared screen
+    if (first_frame) {
+        output += "\033[2J";
+        front.clear();
+        front_known.clear();
+        first_frame = false;
+    }
+    
+    // Rows the frame uses (the last row may be empty if the frame ended with a newline)
+    size_t rows = max(back.size(), front.size());
+    front.resize(rows);
+    front_known.resize(rows, false);
+    
+    // Style the terminal is currently in and where its cursor is (unknown at the start)
+    int current_style = -1;
+    int at_row = -1;
+    int at_column = -1;
+    
+    for (size_t r = 0; r < rows; r++) {
+        const vector<Glyph> empty_row;
+        const vector<Glyph> &next = (r < back.size()) ? back[r] : empty_row;
+        vector<Glyph> &shown = front[r];
+        
+        // Unknown rows are wiped and then drawn like a blank row
+        if (!front_known[r]) {
+            move_to(output, r, 0, at_row, at_column);
+            output += "\033[2K";
+            shown.clear();
+        }
+        
+        // Send each run of changed cells, moving the cursor only where a run starts
+        size_t c = 0;
+        while (c < next.size()) {
+            bool same = c < shown.size() && shown[c].character == next[c].character && shown[c].style == next[c].style;
+            if (same) {
+                c++;
+                continue;
+            }
+            
+            move_to(output, r, c, at_row, at_column);
+            while (c < next.size()
+                   && !(c < shown.size() && shown[c].character == next[c].character && shown[c].style == next[c].style)) {
+                if (next[c].style != current_style) {
+                    output += STYLE_CODES[0];
+                    if (next[c].style != STYLE_PLAIN) {
+                        output += STYLE_CODES[next[c].style];
+                    }
+                    current_style = next[c].style;
+                }
+                output += next[c].character;
+                at_column++;
+                c++;
+            }
+        }
+        
+        // Erase whatever the old row had past the end of the new one
+        if (shown.size() > next.size()) {
+            if (current_style != STYLE_PLAIN) {
+                output += STYLE_CODES[0];
+                current_style = STYLE_PLAIN;
+            }
+            move_to(output, r, next.size(), at_row, at_column);
+            output += "\033[K";
+        }
+        
+        shown = next;
+        front_known[r] = true;
+    }
+    
+    // Leave plain style and put the cursor where the frame ended
+    if (current_style != STYLE_PLAIN) {
+        output += STYLE_CODES[0];
+    }
+    move_to(output, cursor_row, cursor_column, at_row, at_column);
+    
+    // Anything still buffered in cout goes out first, then the whole frame in one write
+    cout << flush;
+    size_t written = 0;
+    while (written < output.size()) {
+        ssize_t sent = write(fd, output.data() + written, output.size() - written);
+        if (sent <= 0) {
+            break;
+        }
+        written += sent;
+    }
+    return output.size();
+}
+
+void Renderer::invalidate_cursor_line() {
+    if ((size_t)cursor_row < front_known.size()) {
+        front_known[cursor_row] = false;
+    }
+}
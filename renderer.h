@@ -0,0 +1,108 @@
+/*
+ * File: renderer.h
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * Double-buffered terminal renderer. Each frame is composed into a grid of cells (a character and a style);
+ * present() compares it with the frame already on screen and sends only the cells that changed, using
+ * cursor-addressing escapes, in a single write. The screen is cleared only for the first frame, so redrawing
+ * after a move costs a few bytes however large the board is.
+ */
+
+#ifndef _renderer_h
+#define _renderer_h
+
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace std;
+
+// Styles a cell can have
+const unsigned char STYLE_PLAIN = 0;
+const unsigned char STYLE_RED = 1;
+const unsigned char STYLE_GREEN = 2;
+
+class Renderer {
+public:
+    /*
+     * Function: Renderer()
+     * Description: Creates a renderer with nothing on screen yet (the first frame clears the screen).
+     * Parameter(s):
+     *     fd: File descriptor frames are written to (the terminal by default).
+     */
+    Renderer(int fd = STDOUT_FILENO);
+
+    /*
+     * Function: begin_frame()
+     * Description: Starts composing a new frame (empty, with the cursor at the top left).
+     * Parameter(s):
+     * Returns: Void.
+     */
+    void begin_frame();
+
+    /*
+     * Function: text()
+     * Description: Adds text to the current line of the frame.
+     * Parameter(s):
+     *     text: Text to add (no newlines or escapes).
+     *     style: STYLE_PLAIN, STYLE_RED or STYLE_GREEN.
+     * Returns: Void.
+     */
+    void text(const string &text, unsigned char style = STYLE_PLAIN);
+
+    /*
+     * Function: newline()
+     * Description: Moves to the start of the next line of the frame.
+     * Parameter(s):
+     * Returns: Void.
+     */
+    void newline();
+
+    /*
+     * Function: present()
+     * Description: Sends the difference between the composed frame and the screen in one write, then leaves
+     *              the terminal cursor where the frame ended (for example after a prompt).
+     * Parameter(s):
+     * Returns: Number of bytes written.
+     */
+    size_t present();
+
+    /*
+     * Function: invalidate_cursor_line()
+     * Description: Marks the line the cursor is on as unknown, so the next frame redraws it completely.
+     *              Call after reading input, because the terminal echoed the typed text onto that line.
+     * Parameter(s):
+     * Returns: Void.
+     */
+    void invalidate_cursor_line();
+
+private:
+    // One character of the screen and its style
+    struct Glyph {
+        char character;
+        unsigned char style;
+    };
+
+    int fd;
+
+    // Frame being composed (back) and frame on screen (front). front_known[r] is false if row r must be redrawn.
+    vector<vector<Glyph> > back;
+    vector<vector<Glyph> > front;
+    vector<bool> front_known;
+
+    // Nothing has been drawn yet, so the screen has to be cleared
+    bool first_frame;
+
+    // Where the composed frame ends (the cursor is left there by present())
+    int cursor_row;
+    int cursor_column;
+
+    // Output of present(), kept to reuse its memory
+    string output;
+};
+
+#endif
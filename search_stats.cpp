@@ -0,0 +1,109 @@
+/*
+ * File: search_stats.cpp
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * This file defines the functions declared in 'search_stats.h'.
+ * Notes:
+ * Comments in this file are implementation level.
+ * More details regarding the purpose and use of each function can be found in 'search_stats.h'.
+ */
+
+#include "search_stats.h"
+#include <sstream>
+#include <iomanip>
+#include <vector>
+
+// Every session so far (the last one is the current one)
+static vector<SessionStats> sessions;
+
+// Show the stats line under the board
+static bool stats_shown = false;
+
+// Session with nothing recorded
+static SessionStats empty_session() {
+    SessionStats session;
+    session.moves = 0;
+    session.nodes = 0;
+    session.terminals = 0;
+    session.cache_hits = 0;
+    session.max_depth = 0;
+    session.last = SearchStats();
+    return session;
+}
+
+void begin_session() {
+    sessions.push_back(empty_session());
+}
+
+void record_move(const SearchStats &stats) {
+    if (sessions.empty()) {
+        begin_session();
+    }
+    
+    SessionStats &session = sessions.back();
+    session.moves++;
+    session.nodes += stats.nodes;
+    session.terminals += stats.terminals;
+    session.cache_hits += stats.cache_hits;
+    if (stats.max_depth > session.max_depth) {
+        session.max_depth = stats.max_depth;
+    }
+    session.latency.add(stats.wall_ns);
+    session.last = stats;
+}
+
+const SessionStats &current_session() {
+    if (sessions.empty()) {
+        begin_session();
+    }
+    return sessions.back();
+}
+
+string stats_line(const SessionStats &session) {
+    ostringstream line;
+    line << fixed << setprecision(1);
+    
+    // Last move
+    line << "[AI: " << session.last.nodes << " nodes, ";
+    if (SEARCH_STATS_ENABLED) {
+        line << session.last.terminals << " terminal, " << session.last.cache_hits << " cache hits, depth "
+             << session.last.max_depth << ", ";
+    }
+    line << session.last.wall_ns / 1000.0 << " us";
+    
+    // Every move of the session
+    line << " | p50 " << session.latency.percentile(0.50) / 1000.0 << " p95 "
+         << session.latency.percentile(0.95) / 1000.0 << " p99 " << session.latency.percentile(0.99) / 1000.0
+         << " us over " << session.moves << " moves]";
+    return line.str();
+}
+
+void set_show_stats(bool show) {
+    stats_shown = show;
+}
+
+bool show_stats() {
+    return stats_shown;
+}
+
+void write_stats_json(ostream &out) {
+    out << "[";
+    for (size_t i = 0; i < sessions.size(); i++) {
+        const SessionStats &session = sessions[i];
+        out << (i > 0 ? ",\n " : "\n ");
+        out << "{\"session\":" << i + 1 << ",\"size\":" << SIZE << ",\"win_length\":" << WIN_LENGTH
+            << ",\"counters\":" << (SEARCH_STATS_ENABLED ? "true" : "false") << ",\"moves\":" << session.moves
+            << ",\"nodes\":" << session.nodes << ",\"terminals\":" << session.terminals
+            << ",\"cache_hits\":" << session.cache_hits << ",\"max_depth\":" << session.max_depth
+            << ",\"total_us\":" << session.latency.total() / 1000.0
+            << ",\"p50_us\":" << session.latency.percentile(0.50) / 1000.0
+            << ",\"p95_us\":" << session.latency.percentile(0.95) / 1000.0
+            << ",\"p99_us\":" << session.latency.percentile(0.99) / 1000.0
+            << ",\"max_us\":" << session.latency.max() / 1000.0 << "}";
+    }
+    out << "\n]" << endl;
+}
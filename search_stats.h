@@ -0,0 +1,93 @@
+/*
+ * File: search_stats.h
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * Per-game statistics of the AI's moves. Each game played with run_game() is a session; the SearchStats of every
+ * AI move (see last_search_stats() in 'tictactoe_helper.h') are added to it, and the move times are kept in a
+ * latency histogram so the session can report p50/p95/p99. Sessions can be shown as a line under the board and
+ * written out as JSON.
+ */
+
+#ifndef _search_stats_h
+#define _search_stats_h
+
+#include "histogram.h"
+#include "tictactoe_helper.h"
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+// Totals of the AI's moves in one game
+struct SessionStats {
+    long long moves;
+    long long nodes;
+    long long terminals;
+    long long cache_hits;
+    int max_depth;
+    
+    // Wall time of each move in nanoseconds
+    LatencyHistogram latency;
+    
+    // The most recent move
+    SearchStats last;
+};
+
+/*
+ * Function: begin_session()
+ * Description: Starts a new session; the moves recorded after this belong to it.
+ * Parameter(s):
+ * Returns: Void.
+ */
+void begin_session();
+
+/*
+ * Function: record_move()
+ * Description: Adds the statistics of one AI move to the current session.
+ * Parameter(s):
+ *     stats: Statistics of the move (usually last_search_stats()).
+ * Returns: Void.
+ */
+void record_move(const SearchStats &stats);
+
+/*
+ * Function: current_session()
+ * Description: Returns the current session (an empty one if begin_session() was never called).
+ * Parameter(s):
+ * Returns: Statistics of the current session.
+ */
+const SessionStats &current_session();
+
+/*
+ * Function: stats_line()
+ * Description: Returns one line describing the session's last move and its move time percentiles, for example
+ *              "[AI: 412 nodes, 98 terminal, 120 cache hits, depth 6, 35.2 us | p50 12.1 p95 40.0 p99 40.0 us]".
+ *              The terminal, cache hit and depth counts only appear when compiled with -DTICTACTOE_STATS.
+ * Parameter(s):
+ *     session: Session to describe.
+ * Returns: The line (without a newline).
+ */
+string stats_line(const SessionStats &session);
+
+/*
+ * Function: set_show_stats() / show_stats()
+ * Description: Turns the stats line under the board in run_game() on or off (off by default).
+ */
+void set_show_stats(bool show);
+bool show_stats();
+
+/*
+ * Function: write_stats_json()
+ * Description: Writes every session so far as a JSON array, one object per session with its totals and
+ *              its move time percentiles in microseconds.
+ * Parameter(s):
+ *     out: Stream to write to.
+ * Returns: Void.
+ */
+void write_stats_json(ostream &out);
+
+#endif
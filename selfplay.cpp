@@ -0,0 +1,159 @@
+/*
+ * File: selfplay.cpp
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * This file defines the functions declared in 'selfplay.h'.
+ * Notes:
+ * Comments in this file are implementation level.
+ * More details regarding the purpose and use of each function can be found in 'selfplay.h'.
+ */
+
+#include "selfplay.h"
+#include "tictactoe_helper.h"
+#include "game_record.h"
+#include "thread_pool.h"
+#include <iomanip>
+#include <random>
+#include <vector>
+
+// Empty totals
+static SelfPlayResult empty_result() {
+    SelfPlayResult result;
+    result.games = 0;
+    for (int i = 0; i < 2; i++) {
+        result.a_wins[i] = 0;
+        result.b_wins[i] = 0;
+        result.draws[i] = 0;
+    }
+    result.seconds = 0;
+    return result;
+}
+
+// Seed of one game of a run, so any game can be played again from its record on its own
+static uint32_t game_seed(unsigned seed, long long game) {
+    seed_seq sequence = {seed, (unsigned)game};
+    uint32_t result;
+    sequence.generate(&result, &result + 1);
+    return result;
+}
+
+// Play one game on the bitboard, with random numbers from the game's seed, and add it to the totals
+static void play_game(char a, char b, bool a_is_x, uint32_t seed, SelfPlayResult &totals) {
+    mt19937 rng(seed);
+    
+    // The line counts make the end-of-game check after every move O(1)
+    Bitboard empty = {BoardMask(), BoardMask()};
+    Position position = to_position(empty);
+    
+    // Moves in order, for the game record
+    uint8_t moves[MAX_CELLS];
+    int move_count = 0;
+    
+    while (!terminal(position)) {
+        // Find out whose move it is
+        char turn = player(position);
+        bool a_to_move = (turn == X) == a_is_x;
+        
+        // Time only the move choice itself
+        long long start = now_ns();
+        int cell = ai_cell(position.board, turn, a_to_move ? a : b, rng);
+        long long elapsed = now_ns() - start;
+        
+        (a_to_move ? totals.a_latency : totals.b_latency).add(elapsed);
+        make_move(position, cell, turn);
+        moves[move_count++] = cell;
+    }
+    
+    // Count the result from A's point of view
+    int color = a_is_x ? 0 : 1;
+    char won = winner(position);
+    
+    if (game_record() != nullptr) {
+        char result = (won == X || won == O) ? won : RECORD_TIE;
+        GameRecord game = {SIZE, WIN_LENGTH, a_is_x ? a : b, a_is_x ? b : a, result, seed, move_count, moves};
+        game_record()->add(game);
+    }
+    if (won != X && won != O) {
+        totals.draws[color]++;
+    }
+    else if ((won == X) == a_is_x) {
+        totals.a_wins[color]++;
+    }
+    else {
+        totals.b_wins[color]++;
+    }
+    totals.games++;
+}
+
+SelfPlayResult self_play(char a, char b, long long games, int workers, unsigned seed) {
+    if (workers < 1) {
+        workers = 1;
+    }
+    
+    // Every worker already keeps a core busy, so the search itself stays on the worker
+    int previous_threads = search_threads();
+    set_search_threads(1);
+    
+    long long start = now_ns();
+    SelfPlayResult total = run_strided(workers, games, empty_result(), [&](int) {
+        return [&](long long game, SelfPlayResult &totals) {
+            play_game(a, b, game % 2 == 0, game_seed(seed, game), totals);
+        };
+    }, [](SelfPlayResult &total, const SelfPlayResult &part) {
+        total.games += part.games;
+        for (int i = 0; i < 2; i++) {
+            total.a_wins[i] += part.a_wins[i];
+            total.b_wins[i] += part.b_wins[i];
+            total.draws[i] += part.draws[i];
+        }
+        total.a_latency.merge(part.a_latency);
+        total.b_latency.merge(part.b_latency);
+    });
+    total.seconds = (now_ns() - start) / 1e9;
+    
+    set_search_threads(previous_threads);
+    return total;
+}
+
+// Percent of the games, 0 if there were none
+static double percent(long long count, long long games) {
+    return games > 0 ? 100.0 * count / games : 0;
+}
+
+// One line of move latency percentiles, in microseconds
+static void print_latency(ostream &out, const string &label, const LatencyHistogram &latency) {
+    out << label << " move latency (us): p50 " << latency.percentile(0.50) / 1000.0
+        << ", p95 " << latency.percentile(0.95) / 1000.0
+        << ", p99 " << latency.percentile(0.99) / 1000.0
+        << ", max " << latency.max() / 1000.0
+        << " (" << latency.count() << " moves)" << endl;
+}
+
+void print_self_play(ostream &out, char a, char b, const SelfPlayResult &result) {
+    long long a_wins = result.a_wins[0] + result.a_wins[1];
+    long long b_wins = result.b_wins[0] + result.b_wins[1];
+    long long draws = result.draws[0] + result.draws[1];
+    
+    // Games where each side played X
+    long long a_as_x = result.a_wins[0] + result.b_wins[0] + result.draws[0];
+    long long b_as_x = result.a_wins[1] + result.b_wins[1] + result.draws[1];
+    
+    out << fixed << setprecision(2);
+    out << "A (" << a << ") vs B (" << b << "), " << result.games << " games on " << SIZE << "x" << SIZE
+        << " (" << WIN_LENGTH << " in a row)" << endl;
+    out << "A wins: " << a_wins << " (" << percent(a_wins, result.games) << "%)" << endl;
+    out << "B wins: " << b_wins << " (" << percent(b_wins, result.games) << "%)" << endl;
+    out << "Draws:  " << draws << " (" << percent(draws, result.games) << "%)" << endl;
+    out << "A as X: " << percent(result.a_wins[0], a_as_x) << "% A / " << percent(result.b_wins[0], a_as_x)
+        << "% B / " << percent(result.draws[0], a_as_x) << "% draw" << endl;
+    out << "B as X: " << percent(result.a_wins[1], b_as_x) << "% A / " << percent(result.b_wins[1], b_as_x)
+        << "% B / " << percent(result.draws[1], b_as_x) << "% draw" << endl;
+    out << "Time: " << result.seconds << " s, "
+        << (result.seconds > 0 ? result.games / result.seconds : 0) << " games/s" << endl;
+    print_latency(out, "A", result.a_latency);
+    print_latency(out, "B", result.b_latency);
+}
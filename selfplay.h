@@ -0,0 +1,66 @@
+/*
+ * File: selfplay.h
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * Headless self-play: two difficulty levels play each other for many games without any screen output.
+ * Games are spread over worker threads and the totals are reported as win/draw/loss rates, games per second
+ * and per-move latency percentiles. Used to calibrate the random move chances of the difficulty levels
+ * (see random_move_chance() in 'tictactoe_helper.h').
+ */
+
+#ifndef _selfplay_h
+#define _selfplay_h
+
+#include "histogram.h"
+#include <iostream>
+
+using namespace std;
+
+// Totals of a self-play run. Index 0 of each pair is for games where A played X, index 1 for games where B played X.
+struct SelfPlayResult {
+    long long games;
+    long long a_wins[2];
+    long long b_wins[2];
+    long long draws[2];
+    double seconds;
+    
+    // Time each side took per move, in nanoseconds
+    LatencyHistogram a_latency;
+    LatencyHistogram b_latency;
+};
+
+/*
+ * Function: self_play()
+ * Description: Plays games between difficulty levels A and B on the current board size (see set_board_size()).
+ *              A plays X in even-numbered games and O in odd-numbered ones. Every game has its own random
+ *              number generator, seeded from the run's seed and the game's number (the seed the game record
+ *              keeps), so a run is repeatable for a given seed whatever the number of workers. Each move is searched on the calling worker (search threads are set to 1
+ *              for the run and restored afterwards). Finished games are added to the game record, if one is set
+ *              (see set_game_record() in 'game_record.h').
+ * Parameter(s):
+ *     a: Difficulty of player A ('E', 'N', 'I' or 'R' for random).
+ *     b: Difficulty of player B.
+ *     games: Number of games to play.
+ *     workers: Number of worker threads (at least 1).
+ *     seed: Seed for the random moves.
+ * Returns: Totals of the run.
+ */
+SelfPlayResult self_play(char a, char b, long long games, int workers, unsigned seed);
+
+/*
+ * Function: print_self_play()
+ * Description: Prints the totals of a self-play run in a readable form.
+ * Parameter(s):
+ *     out: Stream to print to.
+ *     a: Difficulty of player A.
+ *     b: Difficulty of player B.
+ *     result: Totals returned by self_play().
+ * Returns: Void.
+ */
+void print_self_play(ostream &out, char a, char b, const SelfPlayResult &result);
+
+#endif
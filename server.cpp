@@ -0,0 +1,593 @@
+/*
+ * File: server.cpp
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * This file defines the functions declared in 'server.h'.
+ * Notes:
+ * Comments in this file are implementation level.
+ * More details regarding the purpose and use of each function can be found in 'server.h'.
+ */
+
+#include "server.h"
+#include "tictactoe_helper.h"
+#include "game_record.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <netinet/in.h>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+// Longest command line accepted before the connection is dropped
+const size_t MAX_LINE = 256;
+
+// One connection and its game
+struct Session {
+    // Bytes read but not yet ending in a newline, and bytes waiting to be sent
+    string input;
+    string output;
+    
+    // Current game (game is 0 before the first "new")
+    vector<vector<char> > board;
+    char human;
+    char AI;
+    char difficulty;
+    uint64_t game;
+    
+    // Moves in order and the seed of the game's random numbers, for the game record (see 'game_record.h').
+    // The generator is shared with the worker computing the AI's move, which may outlive the session.
+    vector<uint8_t> moves;
+    uint32_t seed;
+    shared_ptr<mt19937> rng;
+    
+    // The AI is choosing a move
+    bool thinking;
+    
+    // Close once the output is sent
+    bool closing;
+    
+    // The client shut down its side of the connection: no more commands come, so close once the replies
+    // (including the AI's move, if it is still thinking) are sent
+    bool input_closed;
+};
+
+// AI move to compute, and its answer
+struct AIJob {
+    int fd;
+    uint64_t game;
+    vector<vector<char> > board;
+    char AI;
+    char difficulty;
+    shared_ptr<mt19937> rng;
+};
+
+struct AIResult {
+    int fd;
+    uint64_t game;
+    int cell;
+};
+
+// Threads that compute AI moves. Finished moves are queued and the event loop is woken through an eventfd.
+class AIWorkers {
+public:
+    AIWorkers(int threads, int wake_fd) {
+        this->wake_fd = wake_fd;
+        stopping = false;
+        for (int i = 0; i < threads; i++) {
+            workers.push_back(thread(&AIWorkers::work, this));
+        }
+    }
+    
+    ~AIWorkers() {
+        {
+            lock_guard<mutex> lock(jobs_mutex);
+            stopping = true;
+        }
+        job_ready.notify_all();
+        for (size_t i = 0; i < workers.size(); i++) {
+            workers[i].join();
+        }
+    }
+    
+    void submit(const AIJob &job) {
+        {
+            lock_guard<mutex> lock(jobs_mutex);
+            jobs.push_back(job);
+        }
+        job_ready.notify_one();
+    }
+    
+    // Every move finished since the last call
+    vector<AIResult> take_results() {
+        lock_guard<mutex> lock(results_mutex);
+        vector<AIResult> taken;
+        taken.swap(results);
+        return taken;
+    }
+    
+private:
+    void work() {
+        while (true) {
+            AIJob job;
+            {
+                unique_lock<mutex> lock(jobs_mutex);
+                job_ready.wait(lock, [this]() { return stopping || !jobs.empty(); });
+                if (stopping) {
+                    return;
+                }
+                job = jobs.front();
+                jobs.pop_front();
+            }
+            
+            AIResult result = {job.fd, job.game, ai_cell(to_bitboard(job.board), job.AI, job.difficulty, *job.rng)};
+            {
+                lock_guard<mutex> lock(results_mutex);
+                results.push_back(result);
+            }
+            
+            // Wake the event loop
+            uint64_t one = 1;
+            ssize_t written = write(wake_fd, &one, sizeof(one));
+            (void)written;
+        }
+    }
+    
+    vector<thread> workers;
+    int wake_fd;
+    
+    mutex jobs_mutex;
+    condition_variable job_ready;
+    deque<AIJob> jobs;
+    bool stopping;
+    
+    mutex results_mutex;
+    vector<AIResult> results;
+};
+
+// Open a listening socket: a Unix socket if the address is a path, TCP otherwise. Returns -1 on failure.
+static int open_listener(const string &address) {
+    int fd;
+    
+    if (address.find('/') != string::npos) {
+        sockaddr_un local;
+        memset(&local, 0, sizeof(local));
+        local.sun_family = AF_UNIX;
+        if (address.size() >= sizeof(local.sun_path)) {
+            return -1;
+        }
+        strcpy(local.sun_path, address.c_str());
+        
+        // Remove the socket file a previous run left behind
+        unlink(address.c_str());
+        
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        if (fd < 0 || bind(fd, (sockaddr *)&local, sizeof(local)) < 0) {
+            return -1;
+        }
+    }
+    else {
+        // host:port or just port (on 127.0.0.1)
+        string host = "127.0.0.1";
+        string port = address;
+        size_t colon = address.rfind(':');
+        if (colon != string::npos) {
+            host = address.substr(0, colon);
+            port = address.substr(colon + 1);
+        }
+        
+        sockaddr_in local;
+        memset(&local, 0, sizeof(local));
+        local.sin_family = AF_INET;
+        local.sin_port = htons(atoi(port.c_str()));
+        if (inet_pton(AF_INET, host.c_str(), &local.sin_addr) != 1) {
+            return -1;
+        }
+        
+        fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        if (fd < 0) {
+            return -1;
+        }
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if (bind(fd, (sockaddr *)&local, sizeof(local)) < 0) {
+            return -1;
+        }
+    }
+    
+    if (listen(fd, SOMAXCONN) < 0) {
+        return -1;
+    }
+    return fd;
+}
+
+// "<cells> <turn> <status>" for a session's game
+static string describe(const vector<vector<char> > &board, bool thinking) {
+    string text;
+    for (int i = 0; i < SIZE; i++) {
+        for (int j = 0; j < SIZE; j++) {
+            char cell = board[i][j];
+            text += (cell == X || cell == O) ? cell : '.';
+        }
+    }
+    text += ' ';
+    text += player(board);
+    
+    // Status of the game
+    if (!terminal(board)) {
+        text += thinking ? " thinking" : " playing";
+    }
+    else {
+        char won = winner(board);
+        text += (won == X) ? " x_wins" : (won == O) ? " o_wins" : " tie";
+    }
+    return text;
+}
+
+// Global counter so every game has its own number (answers for an older game are dropped)
+static uint64_t next_game = 1;
+
+// Hand the AI's move to the workers
+static void start_ai_move(int fd, Session &session, AIWorkers &workers) {
+    session.thinking = true;
+    workers.submit({fd, session.game, session.board, session.AI, session.difficulty, session.rng});
+}
+
+// Play a move of the session's game, and add the game to the record if the move ended it
+static void play(Session &session, pair<int, int> coordinates, char turn) {
+    update(session.board, coordinates, turn);
+    session.moves.push_back(coordinates.first * SIZE + coordinates.second);
+    if (!terminal(session.board) || game_record() == nullptr) {
+        return;
+    }
+    
+    char won = winner(session.board);
+    GameRecord game = {SIZE, WIN_LENGTH, session.human == X ? RECORD_HUMAN : session.difficulty,
+                       session.human == O ? RECORD_HUMAN : session.difficulty, won != ' ' ? won : RECORD_TIE,
+                       session.seed, (int)session.moves.size(), session.moves.data()};
+    game_record()->add(game);
+    
+    // The server only stops when it is killed, so every game is written right away
+    game_record()->flush();
+}
+
+// Run one command line and queue its reply
+static void handle_command(int fd, Session &session, const string &line, AIWorkers &workers) {
+    istringstream words(line);
+    string command;
+    words >> command;
+    
+    if (command == "new") {
+        // Optional side and difficulty, in that order
+        string side = "X";
+        string level = "I";
+        words >> side >> level;
+        char human = toupper(side[0]);
+        char difficulty = toupper(level[0]);
+        if (side.size() != 1 || (human != X && human != O)) {
+            session.output += "error side must be X or O\n";
+            return;
+        }
+        if (level.size() != 1 || string("ENIR").find(difficulty) == string::npos) {
+            session.output += "error difficulty must be E, N, I or R\n";
+            return;
+        }
+        
+        // A new game number makes any move still being computed for the old game stale
+        session.board = empty_board();
+        session.human = human;
+        session.AI = (human == X) ? O : X;
+        session.difficulty = difficulty;
+        session.game = next_game++;
+        session.thinking = false;
+        session.moves.clear();
+        session.seed = random_device{}();
+        session.rng = make_shared<mt19937>(session.seed);
+        
+        // X moves first
+        if (session.AI == X) {
+            start_ai_move(fd, session, workers);
+        }
+        session.output += "ok " + describe(session.board, session.thinking) + "\n";
+    }
+    else if (command == "move") {
+        if (session.game == 0) {
+            session.output += "error no game\n";
+            return;
+        }
+        if (terminal(session.board)) {
+            session.output += "error game over\n";
+            return;
+        }
+        if (session.thinking) {
+            session.output += "error not your turn\n";
+            return;
+        }
+        
+        // Same parsing as the interactive game
+        string rest;
+        getline(words, rest);
+        pair<int, int> coordinates;
+        try {
+            coordinates = parse_input(rest);
+        }
+        catch (const invalid_argument&) {
+            coordinates = {-1, -1};
+        }
+        catch (const out_of_range&) {
+            coordinates = {-1, -1};
+        }
+        
+        // Must be on the grid and empty
+        pair<int, int> sentinel {-1, -1};
+        if (coordinates == sentinel || session.board[coordinates.first][coordinates.second] != ' ') {
+            session.output += "error invalid move\n";
+            return;
+        }
+        
+        play(session, coordinates, session.human);
+        if (!terminal(session.board)) {
+            start_ai_move(fd, session, workers);
+        }
+        session.output += "ok " + describe(session.board, session.thinking) + "\n";
+    }
+    else if (command == "state") {
+        if (session.game == 0) {
+            session.output += "error no game\n";
+            return;
+        }
+        session.output += "ok " + describe(session.board, session.thinking) + "\n";
+    }
+    else if (command == "quit") {
+        session.output += "ok bye\n";
+        session.closing = true;
+    }
+    else {
+        session.output += "error unknown command\n";
+    }
+}
+
+// Send as much output as the socket takes. Returns false if the connection failed.
+static bool flush_output(int fd, Session &session) {
+    while (!session.output.empty()) {
+        ssize_t sent = send(fd, session.output.data(), session.output.size(), MSG_NOSIGNAL);
+        if (sent < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        session.output.erase(0, sent);
+    }
+    return true;
+}
+
+int run_server(const string &address, int workers) {
+    if (workers < 1) {
+        workers = 1;
+    }
+    
+    // Every session holds a descriptor, so allow as many as the system lets this process have
+    rlimit files;
+    if (getrlimit(RLIMIT_NOFILE, &files) == 0 && files.rlim_cur < files.rlim_max) {
+        files.rlim_cur = files.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &files);
+    }
+    
+    int listener = open_listener(address);
+    if (listener < 0) {
+        cout << "Could not listen on " << address << ": " << strerror(errno) << endl;
+        return 1;
+    }
+    
+    // The workers write to wake_fd whenever a move is ready
+    int epoll_fd = epoll_create1(0);
+    int wake_fd = eventfd(0, EFD_NONBLOCK);
+    AIWorkers ai(workers, wake_fd);
+    
+    // Kept free for when the descriptors run out: it is closed to accept the waiting connection and turn it away,
+    // since a pending connection would otherwise keep the listener readable and epoll_wait() would never block
+    int spare_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+    
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = listener;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listener, &event);
+    event.data.fd = wake_fd;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &event);
+    
+    // Sessions by socket
+    unordered_map<int, Session> sessions;
+    
+    // Which events each socket is registered for: EPOLLIN until the client shuts down its side (the end of the
+    // input would stay readable), and EPOLLOUT only while output is waiting
+    auto watch = [&](int fd, Session &session) {
+        epoll_event change;
+        change.events = (session.input_closed ? 0u : (uint32_t)EPOLLIN) |
+                        (session.output.empty() ? 0u : (uint32_t)EPOLLOUT);
+        change.data.fd = fd;
+        epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &change);
+    };
+    
+    auto close_session = [&](int fd) {
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        sessions.erase(fd);
+    };
+    
+    // Send what a session has waiting, then close it or update what it waits for
+    auto finish = [&](int fd, Session &session) {
+        bool done = session.closing || (session.input_closed && !session.thinking);
+        if (!flush_output(fd, session) || (done && session.output.empty())) {
+            close_session(fd);
+            return;
+        }
+        watch(fd, session);
+    };
+    
+    cout << "Serving games on " << address << " with " << workers << " AI worker(s)" << endl;
+    
+    vector<epoll_event> events(256);
+    while (true) {
+        int ready = epoll_wait(epoll_fd, events.data(), events.size(), -1);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        
+        for (int e = 0; e < ready; e++) {
+            int fd = events[e].data.fd;
+            
+            // New connections
+            if (fd == listener) {
+                while (true) {
+                    int client = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK);
+                    if (client < 0 && (errno == EMFILE || errno == ENFILE) && spare_fd >= 0) {
+                        close(spare_fd);
+                        int refused = accept(listener, nullptr, nullptr);
+                        if (refused >= 0) {
+                            close(refused);
+                        }
+                        spare_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+                        
+                        // accept4() runs out of descriptors before it looks for a connection, so stop once none is
+                        // waiting
+                        if (refused < 0) {
+                            break;
+                        }
+                        continue;
+                    }
+                    if (client < 0 && (errno == ECONNABORTED || errno == EINTR)) {
+                        continue;
+                    }
+                    if (client < 0) {
+                        break;
+                    }
+                    
+                    Session &session = sessions[client];
+                    session.human = X;
+                    session.AI = O;
+                    session.difficulty = 'I';
+                    session.game = 0;
+                    session.seed = 0;
+                    session.thinking = false;
+                    session.closing = false;
+                    session.input_closed = false;
+                    
+                    epoll_event added;
+                    added.events = EPOLLIN;
+                    added.data.fd = client;
+                    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, client, &added);
+                }
+                continue;
+            }
+            
+            // AI moves that finished
+            if (fd == wake_fd) {
+                uint64_t count;
+                ssize_t got = read(wake_fd, &count, sizeof(count));
+                (void)got;
+                
+                vector<AIResult> results = ai.take_results();
+                for (size_t r = 0; r < results.size(); r++) {
+                    // Drop the move if the connection closed or a new game started
+                    auto found = sessions.find(results[r].fd);
+                    if (found == sessions.end() || found->second.game != results[r].game) {
+                        continue;
+                    }
+                    
+                    Session &session = found->second;
+                    pair<int, int> coordinates = {results[r].cell / SIZE, results[r].cell % SIZE};
+                    play(session, coordinates, session.AI);
+                    session.thinking = false;
+                    session.output += "ai " + to_string(coordinates.first) + "," + to_string(coordinates.second)
+                                      + " " + describe(session.board, false) + "\n";
+                    finish(results[r].fd, session);
+                }
+                continue;
+            }
+            
+            auto found = sessions.find(fd);
+            if (found == sessions.end()) {
+                continue;
+            }
+            Session &session = found->second;
+            
+            // A connection that failed or closed both ways can't take any more replies
+            if (events[e].events & (EPOLLHUP | EPOLLERR)) {
+                close_session(fd);
+                continue;
+            }
+            
+            // Read everything available and run every complete line
+            if (events[e].events & EPOLLIN) {
+                char buffer[4096];
+                bool open = true;
+                while (true) {
+                    ssize_t got = read(fd, buffer, sizeof(buffer));
+                    if (got > 0) {
+                        session.input.append(buffer, got);
+                        continue;
+                    }
+                    if (got == 0) {
+                        session.input_closed = true;
+                    }
+                    else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                        open = false;
+                    }
+                    break;
+                }
+                
+                size_t newline;
+                while (!session.closing && (newline = session.input.find('\n')) != string::npos) {
+                    string line = session.input.substr(0, newline);
+                    session.input.erase(0, newline + 1);
+                    if (!line.empty() && line.back() == '\r') {
+                        line.pop_back();
+                    }
+                    handle_command(fd, session, line, ai);
+                }
+                
+                // Drop connections that send an endless line
+                if (session.input.size() > MAX_LINE) {
+                    session.output += "error line too long\n";
+                    session.closing = true;
+                }
+                
+                if (!open) {
+                    close_session(fd);
+                    continue;
+                }
+            }
+            
+            finish(fd, session);
+        }
+    }
+    
+    if (spare_fd >= 0) {
+        close(spare_fd);
+    }
+    close(listener);
+    close(wake_fd);
+    close(epoll_fd);
+    return 1;
+}
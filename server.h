@@ -0,0 +1,43 @@
+/*
+ * File: server.h
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * Game server: one process hosts any number of games over a local TCP or Unix socket.
+ * Connections are served by a single epoll event loop; AI moves are computed on worker threads, so a slow search
+ * never stalls the other sessions.
+ *
+ * Protocol (one command per line, one reply line per command):
+ *     new [X|O] [E|N|I|R]    Start a game as X or O (default X) at a difficulty (default I).
+ *     move r,c               Play at row r, column c (same format as the interactive game).
+ *     state                  Show the current game.
+ *     quit                   Close the connection.
+ * Replies are "ok <state>" or "error <reason>". When the AI has moved, the server sends "ai r,c <state>" by itself.
+ * A client that shuts down its side of the connection still gets every reply (and the AI's move, if it is thinking)
+ * before the server closes the connection.
+ * A state is "<cells> <turn> <status>": the cells row by row ('X', 'O' or '.'), the player to move, and one of
+ * playing, thinking (the AI is choosing its move), x_wins, o_wins or tie.
+ */
+
+#ifndef _server_h
+#define _server_h
+
+#include <string>
+
+using namespace std;
+
+/*
+ * Function: run_server()
+ * Description: Listens on the address and serves games until the process is stopped.
+ *              Games use the current board size (see set_board_size()).
+ * Parameter(s):
+ *     address: Unix socket path (anything containing a '/') or a TCP port on 127.0.0.1, optionally as host:port.
+ *     workers: Number of threads computing AI moves (at least 1).
+ * Returns: 1 if the server could not start (it doesn't return otherwise).
+ */
+int run_server(const string &address, int workers);
+
+#endif
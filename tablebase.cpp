@@ -0,0 +1,327 @@
+/*
+ * File: tablebase.cpp
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * This file defines the functions declared in 'tablebase.h'.
+ * Notes:
+ * Comments in this file are implementation level.
+ * More details regarding the purpose and use of each function can be found in 'tablebase.h'.
+ */
+
+#include "tablebase.h"
+#include "thread_pool.h"
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+// binomial[n][k] = n choose k
+static uint64_t binomial[TABLEBASE_MAX_CELLS + 1][TABLEBASE_MAX_CELLS + 1];
+static bool binomial_ready = false;
+
+// First index of each group of positions (by number of pieces) for a board of `cells` cells; offset[cells + 1]
+// is the total number of positions
+struct TablebaseLayout {
+    int cells;
+    uint64_t offset[TABLEBASE_MAX_CELLS + 2];
+};
+
+// The open tablebase (nullptr if none)
+static const uint8_t *mapped = nullptr;
+static size_t mapped_bytes = 0;
+static TablebaseHeader header;
+static TablebaseLayout mapped_layout;
+
+// Pascal's triangle
+static void build_binomial() {
+    if (binomial_ready) {
+        return;
+    }
+    for (int n = 0; n <= TABLEBASE_MAX_CELLS; n++) {
+        binomial[n][0] = 1;
+        for (int k = 1; k <= TABLEBASE_MAX_CELLS; k++) {
+            binomial[n][k] = (n == 0) ? 0 : binomial[n - 1][k - 1] + binomial[n - 1][k];
+        }
+    }
+    binomial_ready = true;
+}
+
+// X's and O's in a group of `pieces` pieces (X moves first, so X has the extra piece)
+static inline int x_count(int pieces) {
+    return (pieces + 1) / 2;
+}
+
+static inline int o_count(int pieces) {
+    return pieces / 2;
+}
+
+static TablebaseLayout make_layout(int cells) {
+    build_binomial();
+    TablebaseLayout layout;
+    layout.cells = cells;
+    layout.offset[0] = 0;
+    for (int pieces = 0; pieces <= cells; pieces++) {
+        int nx = x_count(pieces);
+        int no = o_count(pieces);
+        layout.offset[pieces + 1] = layout.offset[pieces] + binomial[cells][nx] * binomial[cells - nx][no];
+    }
+    return layout;
+}
+
+// Rank of a set of cells among all sets of the same size (combinatorial number system)
+static inline uint64_t subset_rank(uint32_t mask) {
+    uint64_t rank = 0;
+    int i = 1;
+    while (mask != 0) {
+        rank += binomial[__builtin_ctz(mask)][i++];
+        mask &= mask - 1;
+    }
+    return rank;
+}
+
+// Set of `count` cells with the given rank (inverse of subset_rank)
+static inline uint32_t subset_unrank(uint64_t rank, int count, int cells) {
+    uint32_t mask = 0;
+    int c = cells - 1;
+    for (int i = count; i >= 1; i--) {
+        // Largest cell c with binomial[c][i] <= rank
+        while (binomial[c][i] > rank) {
+            c--;
+        }
+        rank -= binomial[c][i];
+        mask |= 1u << c;
+        c--;
+    }
+    return mask;
+}
+
+// O cells renumbered over the cells X leaves empty, and back
+static inline uint32_t compress(uint32_t o, uint32_t x, int cells) {
+    uint32_t packed = 0;
+    int j = 0;
+    for (int c = 0; c < cells; c++) {
+        if (x & (1u << c)) {
+            continue;
+        }
+        if (o & (1u << c)) {
+            packed |= 1u << j;
+        }
+        j++;
+    }
+    return packed;
+}
+
+static inline uint32_t expand(uint32_t packed, uint32_t x, int cells) {
+    uint32_t o = 0;
+    int j = 0;
+    for (int c = 0; c < cells; c++) {
+        if (x & (1u << c)) {
+            continue;
+        }
+        if (packed & (1u << j)) {
+            o |= 1u << c;
+        }
+        j++;
+    }
+    return o;
+}
+
+// Index of a position (the counts must be legal)
+static inline uint64_t position_index(const TablebaseLayout &layout, uint32_t x, uint32_t o) {
+    int nx = __builtin_popcount(x);
+    int no = __builtin_popcount(o);
+    uint64_t o_ways = binomial[layout.cells - nx][no];
+    return layout.offset[nx + no] + subset_rank(x) * o_ways + subset_rank(compress(o, x, layout.cells));
+}
+
+// Position at an index of a group
+static inline void position_at(const TablebaseLayout &layout, int pieces, uint64_t index, uint32_t &x, uint32_t &o) {
+    int nx = x_count(pieces);
+    int no = o_count(pieces);
+    uint64_t o_ways = binomial[layout.cells - nx][no];
+    uint64_t local = index - layout.offset[pieces];
+    x = subset_unrank(local / o_ways, nx, layout.cells);
+    o = expand(subset_unrank(local % o_ways, no, layout.cells - nx), x, layout.cells);
+}
+
+// 2-bit values, 4 per byte
+static inline int read_value(const uint8_t *values, uint64_t index) {
+    return ((values[index >> 2] >> ((index & 3) * 2)) & 3) - 1;
+}
+
+static inline void write_value(uint8_t *values, uint64_t index, int value) {
+    values[index >> 2] |= (value + 1) << ((index & 3) * 2);
+}
+
+// Bitboard of a position of up to 16 cells
+static inline Bitboard to_board(uint32_t x, uint32_t o) {
+    Bitboard board = {BoardMask(), BoardMask()};
+    board.x.words[0] = x;
+    board.o.words[0] = o;
+    return board;
+}
+
+bool solve_tablebase(const string &path, int threads) {
+    int cells = geometry().cells;
+    if (cells > TABLEBASE_MAX_CELLS) {
+        return false;
+    }
+
+    TablebaseLayout layout = make_layout(cells);
+    uint64_t positions = layout.offset[cells + 1];
+    vector<uint8_t> values((positions + 3) / 4, 0);
+    vector<uint8_t> hints(positions, TABLEBASE_NO_MOVE);
+
+    ThreadPool pool(threads);
+    int chunks = max(1, threads) * 16;
+
+    // Fullest group first: every move from a group leads into the next one, which is already solved
+    for (int pieces = cells; pieces >= 0; pieces--) {
+        uint64_t begin = layout.offset[pieces];
+        uint64_t end = layout.offset[pieces + 1];
+        char turn = (x_count(pieces) == o_count(pieces)) ? 'X' : 'O';
+
+        // Chunks start at multiples of 4, so no two threads write to the same byte of values
+        uint64_t step = ((end - begin) / chunks + 4) & ~(uint64_t)3;
+
+        pool.run(chunks, [&](int task) {
+            uint64_t first = (begin & ~(uint64_t)3) + task * step;
+            uint64_t last = first + step;
+            first = max(first, begin);
+            last = min(last, end);
+
+            for (uint64_t index = first; index < last; index++) {
+                uint32_t x;
+                uint32_t o;
+                position_at(layout, pieces, index, x, o);
+                Bitboard board = to_board(x, o);
+
+                // Finished games are scored as they are
+                if (terminal(board)) {
+                    write_value(values.data(), index, utility(board));
+                    continue;
+                }
+
+                // Same choice as the root of minimax_search(): lowest cell with the best value
+                int best = (turn == 'X') ? -2 : 2;
+                int best_cell = -1;
+                uint32_t occupied = x | o;
+                for (int cell = 0; cell < cells; cell++) {
+                    if (occupied & (1u << cell)) {
+                        continue;
+                    }
+                    uint64_t child = (turn == 'X') ? position_index(layout, x | (1u << cell), o)
+                                                   : position_index(layout, x, o | (1u << cell));
+                    int value = read_value(values.data(), child);
+                    if ((turn == 'X') ? value > best : value < best) {
+                        best = value;
+                        best_cell = cell;
+                    }
+
+                    // A win can't be beaten
+                    if (best == ((turn == 'X') ? 1 : -1)) {
+                        break;
+                    }
+                }
+                write_value(values.data(), index, best);
+                hints[index] = best_cell;
+            }
+        });
+    }
+
+    // Header, values, then hints starting on a 64 byte boundary
+    TablebaseHeader out;
+    memset(&out, 0, sizeof(out));
+    memcpy(out.magic, TABLEBASE_MAGIC, sizeof(out.magic));
+    out.version = TABLEBASE_VERSION;
+    out.size = geometry().size;
+    out.win_length = geometry().win_length;
+    out.positions = positions;
+    out.values_offset = sizeof(TablebaseHeader);
+    out.hints_offset = (out.values_offset + values.size() + 63) & ~(uint64_t)63;
+    out.file_bytes = out.hints_offset + hints.size();
+
+    ofstream file(path, ios::binary | ios::trunc);
+    file.write((const char *)&out, sizeof(out));
+    file.write((const char *)values.data(), values.size());
+    vector<char> padding(out.hints_offset - out.values_offset - values.size(), 0);
+    file.write(padding.data(), padding.size());
+    file.write((const char *)hints.data(), hints.size());
+    file.close();
+    return !file.fail();
+}
+
+bool open_tablebase(const string &path) {
+    // Drop the tablebase opened before
+    if (mapped != nullptr) {
+        munmap((void *)mapped, mapped_bytes);
+        mapped = nullptr;
+    }
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) < 0 || (size_t)info.st_size < sizeof(TablebaseHeader)) {
+        close(fd);
+        return false;
+    }
+
+    void *memory = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) {
+        return false;
+    }
+
+    // Check the header against the file before using it
+    memcpy(&header, memory, sizeof(header));
+    bool valid = memcmp(header.magic, TABLEBASE_MAGIC, sizeof(header.magic)) == 0
+                 && header.version == TABLEBASE_VERSION && header.size * header.size <= TABLEBASE_MAX_CELLS
+                 && header.file_bytes == (uint64_t)info.st_size;
+    if (valid) {
+        mapped_layout = make_layout(header.size * header.size);
+        valid = header.positions == mapped_layout.offset[mapped_layout.cells + 1]
+                && header.values_offset + (header.positions + 3) / 4 <= header.hints_offset
+                && header.hints_offset + header.positions <= header.file_bytes;
+    }
+    if (!valid) {
+        munmap(memory, info.st_size);
+        return false;
+    }
+
+    mapped = (const uint8_t *)memory;
+    mapped_bytes = info.st_size;
+    return true;
+}
+
+bool tablebase_ready() {
+    return mapped != nullptr && (int)header.size == geometry().size && (int)header.win_length == geometry().win_length;
+}
+
+bool tablebase_probe(const Bitboard &board, int &value, int &best_cell) {
+    if (!tablebase_ready()) {
+        return false;
+    }
+
+    uint32_t x = board.x.words[0];
+    uint32_t o = board.o.words[0];
+    int nx = __builtin_popcount(x);
+    int no = __builtin_popcount(o);
+    if (nx != no && nx != no + 1) {
+        return false;
+    }
+
+    uint64_t index = position_index(mapped_layout, x, o);
+    value = read_value(mapped + header.values_offset, index);
+    uint8_t hint = mapped[header.hints_offset + index];
+    best_cell = (hint == TABLEBASE_NO_MOVE) ? -1 : hint;
+    return true;
+}
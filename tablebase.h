@@ -0,0 +1,97 @@
+/*
+ * File: tablebase.h
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * Tablebase of solved positions for small boards (up to 4x4), built offline and memory-mapped at runtime.
+ *
+ * Every position with as many X's as O's (or one X more) gets a dense index. Positions are grouped by the number
+ * of pieces; within a group the index is the rank of the set of X cells (combinatorial number system) times the
+ * number of ways to place the O's, plus the rank of the O cells among the cells X left empty.
+ * The solver goes from the full board back to the empty one (backward induction), solving each group in
+ * parallel from the group after it.
+ *
+ * File layout (all numbers little-endian, as written by the solving machine):
+ *     TablebaseHeader
+ *     values: 2 bits per position, 4 positions per byte (0 = O wins, 1 = tie, 2 = X wins)
+ *     hints: 1 byte per position, the best move's cell (the lowest cell among equally good moves,
+ *            the same move minimax_search() picks), or 255 if the game is over
+ * The file is used in place through mmap, so opening it costs nothing and every process that opens the same
+ * file shares one copy in the page cache.
+ */
+
+#ifndef _tablebase_h
+#define _tablebase_h
+
+#include "bitboard.h"
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+// Largest board the tablebase handles (4x4; 5x5 would have 1.6 * 10^11 positions)
+const int TABLEBASE_MAX_CELLS = 16;
+
+// File identification and version
+const char TABLEBASE_MAGIC[8] = {'T', 'T', 'T', 'B', 'A', 'S', 'E', '\0'};
+const uint32_t TABLEBASE_VERSION = 1;
+
+// Hint of a finished game
+const uint8_t TABLEBASE_NO_MOVE = 255;
+
+// Start of a tablebase file
+struct TablebaseHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t size;
+    uint32_t win_length;
+    uint32_t reserved;
+    uint64_t positions;
+    uint64_t values_offset;
+    uint64_t hints_offset;
+    uint64_t file_bytes;
+};
+
+/*
+ * Function: solve_tablebase()
+ * Description: Solves every position of the current board size (see set_board_size()) and writes the tablebase.
+ * Parameter(s):
+ *     path: File to write.
+ *     threads: Number of threads solving each group of positions.
+ * Returns: Boolean value; true if the file was written, false if the board has more than TABLEBASE_MAX_CELLS cells
+ *          or writing failed.
+ */
+bool solve_tablebase(const string &path, int threads);
+
+/*
+ * Function: open_tablebase()
+ * Description: Maps a tablebase file into memory (read only, shared). Replaces any tablebase opened before.
+ * Parameter(s):
+ *     path: File to open.
+ * Returns: Boolean value; true if the file is a valid tablebase, false otherwise.
+ */
+bool open_tablebase(const string &path);
+
+/*
+ * Function: tablebase_ready()
+ * Description: Checks if a tablebase is open for the current board size and win length.
+ * Parameter(s):
+ * Returns: Boolean value; true if tablebase_probe() can answer positions of the current board.
+ */
+bool tablebase_ready();
+
+/*
+ * Function: tablebase_probe()
+ * Description: Looks a position up in the open tablebase.
+ * Parameter(s):
+ *     board: Bitboard of the position (X's and O's must be equal, or one more X).
+ *     value: Set to the utility of the position (1 if X wins, -1 if O wins, 0 for a tie).
+ *     best_cell: Set to the best move for the player to move, or -1 if the game is over.
+ * Returns: Boolean value; true if the position was found, false if no tablebase is ready or the position is illegal.
+ */
+bool tablebase_probe(const Bitboard &board, int &value, int &best_cell);
+
+#endif
@@ -0,0 +1,99 @@
+/*
+ * File: thread_pool.cpp
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * This file defines the functions declared in 'thread_pool.h'.
+ * Notes:
+ * Comments in this file are implementation level.
+ * More details regarding the purpose and use of each function can be found in 'thread_pool.h'.
+ */
+
+#include "thread_pool.h"
+
+// Start every worker; they sleep until the first batch
+ThreadPool::ThreadPool(int threads) {
+    batch = nullptr;
+    batch_count = 0;
+    next_task = 0;
+    finished = 0;
+    generation = 0;
+    stopping = false;
+
+    if (threads < 1) {
+        threads = 1;
+    }
+    for (int i = 0; i < threads; i++) {
+        workers.push_back(thread(&ThreadPool::work, this));
+    }
+}
+
+// Wake every worker so it sees the stop flag, then wait for them to exit
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(state_mutex);
+        stopping = true;
+    }
+    work_ready.notify_all();
+
+    for (size_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+}
+
+// Publish the batch, then sleep until every task has finished
+void ThreadPool::run(int count, const function<void(int)> &task) {
+    if (count <= 0) {
+        return;
+    }
+
+    lock_guard<mutex> run_lock(run_mutex);
+
+    unique_lock<mutex> lock(state_mutex);
+    batch = &task;
+    batch_count = count;
+    next_task = 0;
+    finished = 0;
+    generation++;
+    work_ready.notify_all();
+
+    work_done.wait(lock, [this]() { return finished == batch_count; });
+    batch = nullptr;
+}
+
+int ThreadPool::size() const {
+    return workers.size();
+}
+
+// Take tasks one at a time until the batch is empty, then wait for the next batch
+void ThreadPool::work() {
+    long long seen = 0;
+    unique_lock<mutex> lock(state_mutex);
+
+    while (true) {
+        work_ready.wait(lock, [this, seen]() { return stopping || (generation != seen && batch != nullptr); });
+        if (stopping) {
+            return;
+        }
+        seen = generation;
+
+        // Hand out tasks until there are none left
+        while (batch != nullptr && next_task < batch_count) {
+            int task = next_task++;
+            const function<void(int)> *current = batch;
+
+            // Run the task without holding the lock
+            lock.unlock();
+            (*current)(task);
+            lock.lock();
+
+            finished++;
+            if (finished == batch_count) {
+                work_done.notify_all();
+            }
+        }
+    }
+}
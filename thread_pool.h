@@ -0,0 +1,120 @@
+/*
+ * File: thread_pool.h
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * Fixed set of worker threads that run batches of numbered tasks.
+ * The threads are started once and reused, so running a batch doesn't pay for creating threads.
+ * run_strided() spreads numbered items such as the games of a match over a pool, with totals kept per worker.
+ */
+
+#ifndef _thread_pool_h
+#define _thread_pool_h
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+class ThreadPool {
+public:
+    /*
+     * Function: ThreadPool()
+     * Description: Starts the worker threads.
+     * Parameter(s):
+     *     threads: Number of worker threads (at least 1).
+     */
+    ThreadPool(int threads);
+
+    /*
+     * Function: ~ThreadPool()
+     * Description: Stops and joins the worker threads.
+     */
+    ~ThreadPool();
+
+    /*
+     * Function: run()
+     * Description: Calls task(i) for every i from 0 to count - 1, spread over the worker threads,
+     *              and waits until every call has returned. Tasks are handed out in order of i.
+     *              Only one batch runs at a time; other callers wait for their turn.
+     * Parameter(s):
+     *     count: Number of tasks.
+     *     task: Function to call with each task number.
+     * Returns: Void.
+     */
+    void run(int count, const function<void(int)> &task);
+
+    /*
+     * Function: size()
+     * Description: Returns the number of worker threads.
+     * Parameter(s):
+     * Returns: Number of worker threads.
+     */
+    int size() const;
+
+private:
+    // Loop run by each worker thread
+    void work();
+
+    vector<thread> workers;
+
+    // Serializes calls to run()
+    mutex run_mutex;
+
+    // Protects everything below
+    mutex state_mutex;
+    condition_variable work_ready;
+    condition_variable work_done;
+
+    // Current batch: the task, how many tasks there are, the next one to hand out, and how many have finished
+    const function<void(int)> *batch;
+    int batch_count;
+    int next_task;
+    int finished;
+
+    // Incremented for every batch so sleeping workers can tell a new batch started
+    long long generation;
+    bool stopping;
+};
+
+/*
+ * Function: run_strided()
+ * Description: Runs count items on a new pool of the given number of workers. Worker w takes the items
+ *              w, w + workers, w + 2 * workers, ..., so each item goes to the same worker on every run with the
+ *              same number of workers. Every worker adds its items to its own copy of empty, and the copies are
+ *              merged in worker order once every item is done.
+ * Parameter(s):
+ *     workers: Number of worker threads (at least 1).
+ *     count: Number of items.
+ *     empty: Totals each worker starts from.
+ *     start: Called once on each worker as start(w); returns the function the worker calls as play(item, totals)
+ *            for each of its items (so it can hold state of its own, such as a random number generator).
+ *     merge: Called as merge(total, part) to add each worker's totals to the result.
+ * Returns: The merged totals.
+ */
+template <class Totals, class Start, class Merge>
+Totals run_strided(int workers, long long count, const Totals &empty, Start start, Merge merge) {
+    vector<Totals> partial(workers, empty);
+    ThreadPool pool(workers);
+    pool.run(workers, [&](int w) {
+        auto play = start(w);
+        for (long long item = w; item < count; item += workers) {
+            play(item, partial[w]);
+        }
+    });
+
+    Totals total = empty;
+    for (int w = 0; w < workers; w++) {
+        merge(total, partial[w]);
+    }
+    return total;
+}
+
+#endif
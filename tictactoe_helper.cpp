@@ -13,84 +13,197 @@
  */
 
 #include "tictactoe_helper.h"
+#include "transposition.h"
+#include "perfect_table.h"
+#include "thread_pool.h"
+#include "search_stats.h"
+#include "renderer.h"
+#include "mcts.h"
+#include "tablebase.h"
+#include "ponder.h"
+#include "fixed_board.h"
+#include "game_record.h"
+#include "anytime.h"
+#include "proof_search.h"
+#include "histogram.h"
 #include <map>
+#include <array>
 #include <algorithm>
 #include <stdexcept>
-#include <chrono>
 #include <thread>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <cmath>
 #include <stdlib.h>
 #include <iostream>
 
-// Define colors
-const string RED = "\033[41m";
-const string GREEN = "\033[42m";
-const string RESET = "\033[0m";
-
-// Define extern consts
-const int SIZE = 3;
+// Define externs (SIZE and WIN_LENGTH are changed by set_board_size())
+int SIZE = 3;
+int WIN_LENGTH = 3;
 const char X = 'X';
 const char O = 'O';
 
+// Add the board and (if turned on and the AI has moved) the stats line to the frame
+static void draw_board(Renderer &screen, const vector<vector<char> > &board) {
+    vector<string> lines = board_lines(board);
+    for (size_t i = 0; i < lines.size(); i++) {
+        screen.text(lines[i]);
+        screen.newline();
+    }
+    
+    if (show_stats() && current_session().moves > 0) {
+        screen.newline();
+        screen.text(stats_line(current_session()));
+        screen.newline();
+    }
+}
+
+// Hint for the player to move: the first best move of the analysis and how the game ends after it
+static string hint_message(const Bitboard &bits, char mover, char difficulty) {
+    // Levels that use MCTS are meant for boards too large to analyze exactly
+    if (ai_backend(difficulty) != BACKEND_MINIMAX) {
+        return "[No hints on this level]";
+    }
+    
+    // Boards too large to analyze get the move of an anytime search instead
+    if (anytime_board()) {
+        int cell = anytime_cell(bits, mover, 0);
+        return "[Hint: (" + to_string(cell / SIZE) + ", " + to_string(cell % SIZE) + "), searched "
+               + to_string(last_anytime_stats().depth) + " plies ahead]";
+    }
+    
+    vector<MoveScore> moves = analyze_root(bits);
+    int sign = (mover == X) ? 1 : -1;
+    size_t best = 0;
+    for (size_t i = 1; i < moves.size(); i++) {
+        if (moves[i].value * sign > moves[best].value * sign) {
+            best = i;
+        }
+    }
+    
+    // The mover makes every other ply, starting with this one
+    const MoveScore &move = moves[best];
+    string hint = "[Hint: (" + to_string(move.cell / SIZE) + ", " + to_string(move.cell % SIZE) + ") ";
+    int turns = (move.depth + 1) / 2;
+    if (move.value * sign > 0) {
+        hint += "wins in " + to_string(turns) + (turns == 1 ? " move]" : " moves]");
+    }
+    else if (move.value * sign < 0) {
+        hint += "loses in " + to_string(turns) + (turns == 1 ? " move]" : " moves]");
+    }
+    else {
+        hint += "ties]";
+    }
+    return hint;
+}
+
 // Runs the game loop
 void run_game(char human, char AI, vector<vector<char> > board, char difficulty) {
     // Run game loop until one player wins
     char turn = 'X';
     string message = "";
+    unsigned char message_style = STYLE_PLAIN;
+    
+    // Frames are drawn by diffing against the previous one (the first frame clears the screen)
+    Renderer screen;
+    
+    // Statistics of this game's AI moves (see 'search_stats.h')
+    begin_session();
+    
+    // Searches the AI's replies while the human thinks (see 'ponder.h')
+    Ponderer ponderer;
+    
+    // Moves in order, for the game record (see 'game_record.h')
+    vector<uint8_t> moves;
+    
+    // Different levels have different probabilities of making the optimal/random move (see random_move_chance()).
+    // Every game seeds its own generator from rand() (so srand() in main still applies) and records the seed.
+    uint32_t seed = rand();
+    mt19937 rng(seed);
+    
     while (true) {
-        cout << "\033[2J\033[1;1H" << flush;
         // Check if game has ended
         if (terminal(board)) {
+            // The human's last move may have ended the game while the AI was pondering
+            ponderer.stop();
             char winner_ = winner(board);
             
+            if (game_record() != nullptr) {
+                GameRecord game = {SIZE, WIN_LENGTH, human == X ? RECORD_HUMAN : difficulty,
+                                   human == O ? RECORD_HUMAN : difficulty, winner_ != ' ' ? winner_ : RECORD_TIE,
+                                   seed, (int)moves.size(), moves.data()};
+                game_record()->add(game);
+            }
+            screen.begin_frame();
+            
             // Check for winner or tie
             if (winner_ != ' ') {
                 // Check if human won
                 if (winner_ == human){
-                    cout << GREEN << "YOU WON!" << RESET << endl;
+                    screen.text("YOU WON!", STYLE_GREEN);
                 }
                 // Otherwise, AI won and human lost
                 else {
-                    cout << RED << "YOU LOST!" << RESET << endl;
+                    screen.text("YOU LOST!", STYLE_RED);
                 }
-                cout << "------------------" << endl << endl;
-                render_board(board);
-                break;
             }
             // Must be a tie
             else {
-                cout << GREEN << "TIE!"<< RESET << endl;
-                cout << "------------------" << endl << endl;
-                render_board(board);
-                break;
+                screen.text("TIE!", STYLE_GREEN);
             }
+            screen.newline();
+            screen.text("------------------");
+            screen.newline();
+            screen.newline();
+            draw_board(screen, board);
+            screen.present();
+            break;
         }
         
-        // Margin
-        cout << endl;
-        
         // Determine if it is the human or AI's turn
         if (turn == human) {
             pair<int, int> coordinates;
             
+            // Start on the AI's replies right away, unless the AI would ignore them (always random, or MCTS)
+            if (pondering() && ai_backend(difficulty) == BACKEND_MINIMAX && random_move_chance(difficulty) < 100) {
+                ponderer.start(to_bitboard(board), AI, difficulty);
+            }
+            
             // Keep looping until valid value
             while (true) {
-                // Flush previous input
-                cout << "\033[2J\033[1;1H" << flush;
+                // Compose the frame over the previous one
+                screen.begin_frame();
                 
                 // Indicate who human is playing as. Also include message if needed (for invalid inputs).
-                cout << "PLAYING AS " << human << " " << message << endl;
-                cout << "------------------" << endl << endl;
+                screen.text("PLAYING AS " + string(1, human) + " ");
+                screen.text(message, message_style);
+                screen.newline();
+                screen.text("------------------");
+                screen.newline();
+                screen.newline();
                 
                 message = "";
+                message_style = STYLE_PLAIN;
                 
                 // Render the board
-                render_board(board);
+                draw_board(screen, board);
                 
                 // Prompt user for coordinates
-                cout << endl << "Enter coordinates of move (row, col): ";
+                screen.newline();
+                screen.text("Enter coordinates of move (row, col), or ? for a hint: ");
+                screen.present();
                 string input;
                 getline(cin, input);
-                cout << '\r';
+                
+                // The terminal echoed the input onto the prompt line
+                screen.invalidate_cursor_line();
+                
+                // Show the best move from the same analysis the Easy and Normal levels sample from
+                if (input == "?" || input == "hint") {
+                    message = hint_message(to_bitboard(board), human, difficulty);
+                    continue;
+                }
                 
                 // Parse coordinates from string to pair<int,int>
                 // Also catch errors (invalid formatting) and indicate that
@@ -98,11 +211,13 @@ void run_game(char human, char AI, vector<vector<char> > board, char difficulty)
                     coordinates = parse_input(input);
                 }
                 catch (const invalid_argument&) {
-                    message = RED + "[Action is invalid]" + RESET;
+                    message = "[Action is invalid]";
+                    message_style = STYLE_RED;
                     continue;
                 }
                 catch (const out_of_range&) {
-                    message = RED + "[Action is invalid]" + RESET;
+                    message = "[Action is invalid]";
+                    message_style = STYLE_RED;
                     continue;
                 }
                 
@@ -110,7 +225,8 @@ void run_game(char human, char AI, vector<vector<char> > board, char difficulty)
                 pair<int, int> sentinel {-1, -1};
                 
                 if (coordinates == sentinel) {
-                    message = RED + "[Action is invalid]" + RESET;
+                    message = "[Action is invalid]";
+                    message_style = STYLE_RED;
                     continue;
                 }
                 
@@ -122,48 +238,33 @@ void run_game(char human, char AI, vector<vector<char> > board, char difficulty)
                     break;
                 }
                 
-                message = RED + "[Action is invalid]" + RESET;
+                message = "[Action is invalid]";
+                message_style = STYLE_RED;
             }
             
             // Update board and hand the turn over to the AI
             update(board, coordinates, human);
+            moves.push_back(coordinates.first * SIZE + coordinates.second);
             turn = AI;
         }
         // AI's turn
         else if (turn == AI) {
-            // Different levels have different probabilities of making the optimal/random move.
+            int cell = ai_cell(to_bitboard(board), AI, difficulty, rng, &ponderer);
+            pair<int, int> coordinates = {cell / SIZE, cell % SIZE};
+            record_move(last_search_stats());
             
-            // Generate random number
-            int probability = rand() % 100;
-            
-            pair<int, int> coordinates;
-            
-            // Easy difficulty, 50% chance of a random move, 50% chance of an optimal move.
-            if (difficulty == 'E') {
-                if (probability < 50) {
-                    coordinates = random_move(board);
-                }
-                else {
-                    coordinates = minimax(board, AI);
-                }
+            // Report how many positions the search visited next to the human's prompt
+            // (random moves and moves answered by the solved table don't search at all)
+            if (last_search_stats().nodes > 0) {
+                message = "[AI searched " + to_string(last_search_stats().nodes) + " positions]";
             }
-            // Normal difficulty, 20% chance of a random move, 80% chance of an optimal move.
-            else if (difficulty == 'N') {
-                if (probability < 35) {
-                    coordinates = random_move(board);
-                }
-                else {
-                    coordinates = minimax(board, AI);
-                }
-            }
-            // Impossible difficulty, 0% chance of a random move, 100% chance of an optimal move!
-            else {
-                // Run minimax to determine optimal move
-                coordinates = minimax(board, AI);
+            else if (last_search_stats().playouts > 0) {
+                message = "[AI ran " + to_string(last_search_stats().playouts) + " playouts]";
             }
             
             // Update board and hand over turn to the human
             update(board, coordinates, AI);
+            moves.push_back(cell);
             turn = human;
         }
     }
@@ -232,43 +333,69 @@ pair<int, int> parse_input(string input) {
     int row = stoi(input.substr(0, comma));
     int col = stoi(input.substr(comma+1));
     
+    // Coordinates outside the grid are invalid too
+    if (row < 0 || row >= SIZE || col < 0 || col >= SIZE) {
+        return {-1, -1};
+    }
+    
     // Return numbers as a pair<int, int>
     pair<int, int> coordinates = {row, col};
     return coordinates;
 }
 
 // Render the board in the terminal.
-void render_board(vector<vector<char> > board) {
+void render_board(const vector<vector<char> > &board) {
+    // Join the lines so the grid goes out in one piece
+    vector<string> lines = board_lines(board);
+    string text;
+    for (size_t i = 0; i < lines.size(); i++) {
+        text += lines[i];
+        text += '\n';
+    }
+    cout << text << flush;
+}
+
+// Lines of the board as render_board() prints them
+vector<string> board_lines(const vector<vector<char> > &board) {
+    vector<string> lines;
+    
+    // Indicators take as many characters as the largest index (2 from 11x11 up)
+    int width = to_string(board.size() - 1).size();
+    
     // Margin
-    cout << "  ";
+    string line = string(width + 1, ' ');
     
     // Grid indicators (rows)
     for (int i = 0; i < board.size(); i++) {
-        cout << i << "  ";
+        string label = to_string(i);
+        line += label + string(width - label.size() + 2, ' ');
     }
-    cout << endl;
+    lines.push_back(line);
     
     for (int i = 0; i < board.size(); i++) {
         // Grid indicator (cols)
-        cout << i << " ";
+        string label = to_string(i);
+        line = label + string(width - label.size() + 1, ' ');
         
-        // Print each coordinate
+        // Add each coordinate
         for (int j = 0; j < board.size(); j++) {
             int pos = board[i][j];
             if (pos == ' ') {
-                cout << ".";
+                line += '.';
             }
             else if (pos == X) {
-                cout << "X";
+                line += 'X';
             }
             else if(pos == O) {
-                cout << "O";
+                line += 'O';
             }
-            cout << "  ";
+            line += string(width + 1, ' ');
         }
         
-        cout << endl;
+        lines.push_back(line);
     }
+    
+    return lines;
 }
 
 // Create an empty board (starting state).
@@ -296,181 +423,830 @@ vector<vector<char> > empty_board() {
 }
 
 // Return true if the game is over, false otherwise.
-bool terminal(vector<vector<char> > &board) {
-    // Check if winner returns a value.
-    if (utility(board) == 1 || utility(board) == -1) {
-        return true;
-    }
+bool terminal(const vector<vector<char> > &board) {
+    return terminal(to_bitboard(board));
+}
+
+// Return current player
+char player(const vector<vector<char> > &board) {
+    return player(to_bitboard(board));
+}
+
+// Returns if X has won the game, O has won, or otherwise.
+char winner(const vector<vector<char> > &board) {
+    return winner(to_bitboard(board));
+}
+
+// Returns 1 if X wins, -1 if O wins, or 0 if tied.
+int utility(const vector<vector<char> > &board) {
+    return utility(to_bitboard(board));
+}
+
+// Return set of all possible actions (i, j) available on the board.
+set<pair<int, int> > actions(const vector<vector<char> > &board) {
+    // Add to set available for each empty cell of the bitboard
+    set<pair<int, int> > available;
     
-    // Check if the grid is full.
-    for (int i = 0; i < board.size(); i++) {
-        for (int j = 0; j < board.size(); j++) {
-            if (board[i][j] == ' ') {
-                return false;
-            }
-        }
+    BoardMask empty = empty_cells(to_bitboard(board));
+    while (any_cell(empty)) {
+        int cell = pop_cell(empty);
+        pair<int, int> location = {cell / SIZE, cell % SIZE};
+        available.insert(location);
     }
     
-    return true;
+    return available;
 }
 
-// Return current player
-char player(vector<vector<char> > board) {
-    // Keep track of how many Xs and Os
-    int X_count = 0;
-    int O_count = 0;
+// Updates board with move (i, j).
+void update(vector<vector<char> > &board, pair<int, int> location, char team) {
+    board[location.first][location.second] = team;
+    return;
+}
+
+// Returns board as a result of move (i, j)
+vector<vector<char> > result(const vector<vector<char> > &board, pair<int, int> location) {
+    vector<vector<char> > next = board;
+    next[location.first][location.second] = player(board);
+    return next;
+}
+
+// Returns a random move
+pair<int, int> random_move(const vector<vector<char> > &board) {
+    // Get all available actions
+    MoveList available_actions;
+    legal_moves(to_bitboard(board), available_actions);
     
-    // Add to respective count each time X/O is found
-    for (int i = 0; i < board.size(); i++) {
-        for (int j = 0; j < board.size(); j++) {
-            if (board[i][j] == X) {
-                X_count++;
-            }
-            else if (board[i][j] == O) {
-                O_count++;
-            }
-        }
+    // Pick a random index
+    int random_index = rand() % available_actions.count;
+    
+    // Return move at random index
+    int cell = available_actions.cells[random_index];
+    pair<int, int> location = {cell / SIZE, cell % SIZE};
+    return location;
+}
+
+// Search state is kept per thread, so several threads can search at once (see set_search_threads())
+
+// Move that last caused a cutoff at each ply (number of pieces on the board), stored as cell + 1 (0 if none)
+static thread_local int killer_moves[MAX_CELLS + 1] = {0};
+
+// Positions visited by the current search on this thread
+static thread_local long long search_nodes = 0;
+
+// Flag that stops the searches of this thread (nullptr if they can't be stopped, see set_search_stop())
+static thread_local const atomic<bool> *search_stop = nullptr;
+
+// True once this thread's search has been told to stop
+static inline bool stop_requested() {
+    return search_stop != nullptr && search_stop->load(memory_order_relaxed);
+}
+
+bool search_stop_requested() {
+    return stop_requested();
+}
+
+// Extra counters, compiled in only with -DTICTACTOE_STATS. STATS(statement) runs the statement only then.
+#ifdef TICTACTOE_STATS
+#define STATS(statement) statement
+
+// Terminal positions, positions settled by the table, and the deepest ply (pieces on the board) reached
+static thread_local long long search_terminals = 0;
+static thread_local long long search_hits = 0;
+static thread_local int search_deepest = 0;
+
+// Remember the ply of a visited position if it is the deepest so far
+static inline void note_depth(const Bitboard &board) {
+    int ply = count_cells(board.x | board.o);
+    if (ply > search_deepest) {
+        search_deepest = ply;
     }
+}
+#else
+#define STATS(statement)
+#endif
+
+// Clear this thread's counters before a search
+static void reset_counters() {
+    search_nodes = 0;
+    STATS(search_terminals = 0);
+    STATS(search_hits = 0);
+    STATS(search_deepest = 0);
+}
+
+// Add this thread's counters to stats (max_depth keeps the deepest ply, made relative to the root by the caller)
+static void collect_counters(SearchStats &stats) {
+    stats.nodes += search_nodes;
+    STATS(stats.terminals += search_terminals);
+    STATS(stats.cache_hits += search_hits);
+    STATS(stats.max_depth = max(stats.max_depth, search_deepest));
+}
+
+// Statistics of the last minimax() call on this thread
+static thread_local SearchStats last_stats = SearchStats();
+
+// Number of threads minimax_search() spreads the root moves over, and the threads themselves
+static int search_thread_count = 1;
+static unique_ptr<ThreadPool> search_pool;
+
+// Fill moves with the empty cells of the board in search order.
+// The transposition table's best move goes first, then the killer move of this ply,
+// then the geometry's move order (cells on the most lines first: for 3x3 center, corners, edges).
+static void ordered_moves(const Bitboard &board, int hint, int ply, MoveList &moves) {
+    const Geometry &g = geometry();
+    BoardMask empty = empty_cells(board);
+    moves.count = 0;
     
-    // Return player based on count
-    if (X_count == O_count) {
-        return X;
+    // Best move from an earlier search of this position
+    if (hint >= 0 && has_cell(empty, hint)) {
+        moves.cells[moves.count++] = hint;
+        remove_cell(empty, hint);
     }
-    else if (X_count < O_count) {
-        return X;
+    
+    // Move that refuted a sibling position
+    int killer = killer_moves[ply] - 1;
+    if (killer >= 0 && has_cell(empty, killer)) {
+        moves.cells[moves.count++] = killer;
+        remove_cell(empty, killer);
     }
-    else if (X_count > O_count) {
-        return O;
+    
+    // Everything else
+    for (int i = 0; i < g.cells; i++) {
+        if (has_cell(empty, g.move_order[i])) {
+            moves.cells[moves.count++] = g.move_order[i];
+        }
+    }
+}
+
+// True if a stored entry settles the position within (alpha, beta)
+static inline bool settles(const TableEntry &entry, int alpha, int beta) {
+    // Exact values always settle it, bounds only if they are outside the window
+    if (entry.bound == BOUND_EXACT) {
+        return true;
+    }
+    if (entry.bound == BOUND_LOWER && entry.value >= beta) {
+        return true;
+    }
+    if (entry.bound == BOUND_UPPER && entry.value <= alpha) {
+        return true;
+    }
+    return false;
+}
+
+// Check the transposition table for a stored value that settles the position within (alpha, beta).
+// Sets hint to the stored best move (or -1) either way.
+static bool probe(const Bitboard &board, int alpha, int beta, int &value, int &hint) {
+    TableEntry entry;
+    hint = -1;
+    if (!transposition_table().lookup(board, entry)) {
+        return false;
     }
     
-    // Sentinel value, some sort of error must have happened.
-    return '?';
+    hint = entry.best_cell;
+    value = entry.value;
+    return settles(entry, alpha, beta);
 }
 
-// Returns if X has won the game, O has won, or otherwise.
-char winner(vector<vector<char> > &board) {
+// What a value searched with the window (alpha, beta) says about the real utility
+static inline Bound bound_of(int value, int alpha, int beta) {
+    // -1 and 1 cannot be improved on, so they are exact even after a cutoff
+    if (value <= alpha && value != -1) {
+        return BOUND_UPPER;
+    }
+    if (value >= beta && value != 1) {
+        return BOUND_LOWER;
+    }
+    return BOUND_EXACT;
+}
+
+// Store the result of searching a position with the window (alpha, beta)
+static void record(const Bitboard &board, int alpha, int beta, int value, int best_cell) {
+    TableEntry entry;
+    entry.value = value;
+    entry.best_cell = best_cell;
+    entry.bound = bound_of(value, alpha, beta);
+    transposition_table().store(board, entry);
+}
+
+static int max_search(Position &position, int alpha, int beta);
+
+// min_value() for a position where it is O's turn. The line counts of the position make the end of the game an O(1)
+// check, and children are made and unmade on the same position, which is back in its original state when this
+// returns.
+static int min_search(Position &position, int alpha, int beta) {
+    const Bitboard &board = position.board;
+    search_nodes++;
+    STATS(note_depth(board));
     
-    for (int i = 0; i < board.size(); i++) {
-        // Check rows
-        if ((board[i][0] == board[i][1]) && (board[i][1] == board[i][2]) && board[i][0] != ' ') {
-            return board[i][0];
+    // Base cases: a player has won, or the grid is full
+    if (terminal(position)) {
+        STATS(search_terminals++);
+        return utility(position);
+    }
+    
+    // Reuse the value if this position (or a rotation/reflection of it) was already solved
+    int v;
+    int hint;
+    if (probe(board, alpha, beta, v, hint)) {
+        STATS(search_hits++);
+        return v;
+    }
+    
+    // Infintely large (1000 is an impossible value)
+    v = 1000;
+    int best_cell = -1;
+    
+    // Mutual recursive backtracking with max_search
+    // Try out each empty cell, return the minimum out of the other player's maximums
+    int ply = geometry().cells - position.empty;
+    MoveList moves;
+    ordered_moves(board, hint, ply, moves);
+    for (int i = 0; i < moves.count; i++) {
+        int cell = moves.cells[i];
+        make_move(position, cell, O);
+        int value = max_search(position, alpha, min(beta, v));
+        unmake_move(position, cell, O);
+        
+        // A stopped search unwinds without storing its unfinished values
+        if (stop_requested()) {
+            return 0;
+        }
+        if (value < v) {
+            v = value;
+            best_cell = cell;
         }
         
-        // Check columns
-        if ((board[0][i] == board[1][i]) && (board[1][i] == board[2][i]) && board[0][i] != ' ') {
-            return board[0][i];
+        // Stop once X can't do better than a score already available elsewhere (alpha),
+        // or once O has a proven win (-1 can't be improved on)
+        if (v <= alpha || v == -1) {
+            killer_moves[ply] = cell + 1;
+            break;
         }
     }
     
-    // Check diagonals (left to right, right to left)
-    if ((((board[0][0] == board[1][1]) && (board[1][1] == board[2][2])) || ((board[0][2] == board[1][1]) && (board[1][1] == board[2][0]))) && board[1][1] != ' ') {
-        return board[1][1];
+    record(board, alpha, beta, v, best_cell);
+    return v;
+}
+
+// max_search() is the same as min_search() with the players swapped
+static int max_search(Position &position, int alpha, int beta) {
+    const Bitboard &board = position.board;
+    search_nodes++;
+    STATS(note_depth(board));
+    
+    // Base cases: a player has won, or the grid is full
+    if (terminal(position)) {
+        STATS(search_terminals++);
+        return utility(position);
     }
     
-    // If satisfied none, must be otherwise (return setinel value)
-    return ' ';
+    // Reuse the value if this position (or a rotation/reflection of it) was already solved
+    int v;
+    int hint;
+    if (probe(board, alpha, beta, v, hint)) {
+        STATS(search_hits++);
+        return v;
+    }
+    
+    // Infintely small (-1000 is an impossible value)
+    v = -1000;
+    int best_cell = -1;
+    
+    // Mutual recursive backtracking with min_search
+    // Try out each empty cell, return the maximum out of the other player's minimums
+    int ply = geometry().cells - position.empty;
+    MoveList moves;
+    ordered_moves(board, hint, ply, moves);
+    for (int i = 0; i < moves.count; i++) {
+        int cell = moves.cells[i];
+        make_move(position, cell, X);
+        int value = min_search(position, max(alpha, v), beta);
+        unmake_move(position, cell, X);
+        
+        // A stopped search unwinds without storing its unfinished values
+        if (stop_requested()) {
+            return 0;
+        }
+        if (value > v) {
+            v = value;
+            best_cell = cell;
+        }
+        
+        // Stop once O can't do better than a score already available elsewhere (beta),
+        // or once X has a proven win (1 can't be improved on)
+        if (v >= beta || v == 1) {
+            killer_moves[ply] = cell + 1;
+            break;
+        }
+    }
+    
+    record(board, alpha, beta, v, best_cell);
+    return v;
 }
 
-// Returns 1 if X wins, -1 if O wins, or 0 if tied.
-int utility(vector<vector<char> > board) {
-    if (winner(board) == X) {
-        return 1;
+// The searches below are min_search() and max_search() for a board fixed at compile time (see 'fixed_board.h').
+// Both players' pieces are one word each, and the end of the game is checked on the lines through the last move.
+// They visit the same positions in the same order and store the same entries as the generic searches.
+
+template <class B> static int fixed_max_search(uint64_t x, uint64_t o, int empty, int last, int alpha, int beta);
+
+// Fill moves with the empty cells in search order (table move, killer move, then B's move order)
+template <class B>
+static inline int fixed_moves(uint64_t free, int hint, int ply, int *moves) {
+    int count = 0;
+    if (hint >= 0 && ((free >> hint) & 1)) {
+        moves[count++] = hint;
+        free &= ~(1ULL << hint);
     }
-    else if (winner(board) == O) {
-        return -1;
+    int killer = killer_moves[ply] - 1;
+    if (killer >= 0 && ((free >> killer) & 1)) {
+        moves[count++] = killer;
+        free &= ~(1ULL << killer);
     }
-    else {
+    for (int i = 0; i < B::CELLS; i++) {
+        int cell = B::TABLES.move_order[i];
+        if ((free >> cell) & 1) {
+            moves[count++] = cell;
+        }
+    }
+    return count;
+}
+
+// O to move; last is X's last move (-1 at the top, whose board the caller checked)
+template <class B>
+static int fixed_min_search(uint64_t x, uint64_t o, int empty, int last, int alpha, int beta) {
+    search_nodes++;
+    STATS(search_deepest = max(search_deepest, B::CELLS - empty));
+    
+    // Base cases: X's last move completed a line, or the grid is full
+    if (last >= 0 && B::completes_line(x, last)) {
+        STATS(search_terminals++);
+        return 1;
+    }
+    if (empty == 0) {
+        STATS(search_terminals++);
         return 0;
     }
+    
+    // The canonical key serves both the lookup and the store
+    int symmetry;
+    uint64_t key = B::canonical_key(x, o, symmetry);
+    TableEntry entry;
+    int hint = -1;
+    if (transposition_table().lookup_key(key, entry)) {
+        hint = (entry.best_cell < 0) ? -1 : B::TABLES.inverse_symmetry[symmetry][entry.best_cell];
+        if (settles(entry, alpha, beta)) {
+            STATS(search_hits++);
+            return entry.value;
+        }
+    }
+    
+    int v = 1000;
+    int best_cell = -1;
+    int ply = B::CELLS - empty;
+    int moves[B::CELLS];
+    int count = fixed_moves<B>(B::FULL & ~(x | o), hint, ply, moves);
+    for (int i = 0; i < count; i++) {
+        int cell = moves[i];
+        int value = fixed_max_search<B>(x, o | (1ULL << cell), empty - 1, cell, alpha, min(beta, v));
+        
+        // A stopped search unwinds without storing its unfinished values
+        if (stop_requested()) {
+            return 0;
+        }
+        if (value < v) {
+            v = value;
+            best_cell = cell;
+        }
+        if (v <= alpha || v == -1) {
+            killer_moves[ply] = cell + 1;
+            break;
+        }
+    }
+    
+    entry.value = v;
+    entry.bound = bound_of(v, alpha, beta);
+    entry.best_cell = (best_cell < 0) ? -1 : B::TABLES.symmetry[symmetry][best_cell];
+    transposition_table().store_key(key, entry);
+    return v;
 }
 
-// Return set of all possible actions (i, j) available on the board.
-set<pair<int, int> > actions(vector<vector<char> > &board) {
-    // Add to vector available each time an empty coordinate is found
-    set<pair<int, int> > available;
+// fixed_max_search() is the same as fixed_min_search() with the players swapped
+template <class B>
+static int fixed_max_search(uint64_t x, uint64_t o, int empty, int last, int alpha, int beta) {
+    search_nodes++;
+    STATS(search_deepest = max(search_deepest, B::CELLS - empty));
     
-    for (int i = 0; i < board.size(); i++) {
-        for (int j = 0; j < board.size(); j++) {
-            if (board[i][j] == ' ') {
-                pair<int, int> location = {i, j};
-                available.insert(location);
-            }
+    // Base cases: O's last move completed a line, or the grid is full
+    if (last >= 0 && B::completes_line(o, last)) {
+        STATS(search_terminals++);
+        return -1;
+    }
+    if (empty == 0) {
+        STATS(search_terminals++);
+        return 0;
+    }
+    
+    int symmetry;
+    uint64_t key = B::canonical_key(x, o, symmetry);
+    TableEntry entry;
+    int hint = -1;
+    if (transposition_table().lookup_key(key, entry)) {
+        hint = (entry.best_cell < 0) ? -1 : B::TABLES.inverse_symmetry[symmetry][entry.best_cell];
+        if (settles(entry, alpha, beta)) {
+            STATS(search_hits++);
+            return entry.value;
         }
     }
     
-    return available;
+    int v = -1000;
+    int best_cell = -1;
+    int ply = B::CELLS - empty;
+    int moves[B::CELLS];
+    int count = fixed_moves<B>(B::FULL & ~(x | o), hint, ply, moves);
+    for (int i = 0; i < count; i++) {
+        int cell = moves[i];
+        int value = fixed_min_search<B>(x | (1ULL << cell), o, empty - 1, cell, max(alpha, v), beta);
+        
+        // A stopped search unwinds without storing its unfinished values
+        if (stop_requested()) {
+            return 0;
+        }
+        if (value > v) {
+            v = value;
+            best_cell = cell;
+        }
+        if (v >= beta || v == 1) {
+            killer_moves[ply] = cell + 1;
+            break;
+        }
+    }
+    
+    entry.value = v;
+    entry.bound = bound_of(v, alpha, beta);
+    entry.best_cell = (best_cell < 0) ? -1 : B::TABLES.symmetry[symmetry][best_cell];
+    transposition_table().store_key(key, entry);
+    return v;
 }
 
-// Updates board with move (i, j).
-void update(vector<vector<char> > &board, pair<int, int> location, char team) {
-    board[location.first][location.second] = team;
-    return;
+// Entry points for a board that isn't over (the caller checks, since the last move isn't known here)
+template <class B>
+static int fixed_min_value(const Bitboard &board, int alpha, int beta) {
+    uint64_t x = board.x.words[0];
+    uint64_t o = board.o.words[0];
+    return fixed_min_search<B>(x, o, B::CELLS - __builtin_popcountll(x | o), -1, alpha, beta);
 }
 
-// Returns board as a result of move (i, j)
-vector<vector<char> > result(vector<vector<char> > board, pair<int, int> location) {
-    board[location.first][location.second] = player(board);
-    return board;
+template <class B>
+static int fixed_max_value(const Bitboard &board, int alpha, int beta) {
+    uint64_t x = board.x.words[0];
+    uint64_t o = board.o.words[0];
+    return fixed_max_search<B>(x, o, B::CELLS - __builtin_popcountll(x | o), -1, alpha, beta);
 }
 
-// Returns a random move
-pair<int, int> random_move(vector<vector<char> > &board) {
-    // Get all available actions
-    set<pair<int, int> > available_actions_set = actions(board);
-    vector<pair<int,int> > available_actions(available_actions_set.begin(), available_actions_set.end());
-    
-    // Pick a random index
-    int random_index = rand() % (available_actions.size());
-    
-    // Return move at random index
-    return available_actions[random_index];
+// Boards with a compiled search, and its two entry points
+struct FixedSearch {
+    int size;
+    int win_length;
+    int (*min_value)(const Bitboard &, int, int);
+    int (*max_value)(const Bitboard &, int, int);
+};
+
+#define FIXED_SEARCH(n, k) {n, k, &fixed_min_value<FixedBoard<n, k> >, &fixed_max_value<FixedBoard<n, k> >}
+static const FixedSearch fixed_searches[] = {
+    FIXED_SEARCH(3, 3),
+    FIXED_SEARCH(4, 3),
+    FIXED_SEARCH(4, 4),
+    FIXED_SEARCH(5, 3),
+    FIXED_SEARCH(5, 4),
+    FIXED_SEARCH(5, 5),
+};
+#undef FIXED_SEARCH
+
+// Whether min_value() and max_value() use the compiled searches (see set_fixed_search())
+static bool fixed_search_enabled = true;
+
+// Compiled search of the current board, nullptr if there is none (or they are turned off)
+static const FixedSearch *fixed_search() {
+    if (!fixed_search_enabled) {
+        return nullptr;
+    }
+    for (const FixedSearch &search : fixed_searches) {
+        if (search.size == SIZE && search.win_length == WIN_LENGTH) {
+            return &search;
+        }
+    }
+    return nullptr;
+}
+
+void set_fixed_search(bool enabled) {
+    fixed_search_enabled = enabled;
+}
+
+bool fixed_search_available() {
+    return fixed_search() != nullptr;
 }
 
 // Return lowest possible utility (score) given that both players play optimally.
 // This function represents player O trying to minimize score.
-int min_value(vector<vector<char> > board) {
-    // Base case
-    if (terminal(board)) {
-        // Return 
-        return utility(board);
+int min_value(const Bitboard &board, int alpha, int beta) {
+    // Boards with a compiled search use it (finished boards are left to the generic search, which checks every line)
+    const FixedSearch *fixed = fixed_search();
+    if (fixed != nullptr && !terminal(board)) {
+        return fixed->min_value(board, alpha, beta);
     }
     
-    // Infintely large (1000 is an impossible value)
-    int v = 1000;
-    
-    // Mutual recursive backtracking with max_value
-    // Try out each action, return the minimum out of the other player's maximums
-    for (pair<int, int> action : actions(board)) {
-        v = min(v, max_value(result(board, action)));
-    }
-    return v;
+    // The search plays its moves on one position, counting the pieces on every line once here
+    Position work = to_position(board);
+    return min_search(work, alpha, beta);
 }
 
 // Return highest possible utility (score) given that both players play optimally. (Opposite of min_value)
 // This function represents player X trying to maximize score.
-int max_value(vector<vector<char> > board) {
-    // Base case
-    if (terminal(board)) {
-        return utility(board);
+int max_value(const Bitboard &board, int alpha, int beta) {
+    // Boards with a compiled search use it
+    const FixedSearch *fixed = fixed_search();
+    if (fixed != nullptr && !terminal(board)) {
+        return fixed->max_value(board, alpha, beta);
     }
     
-    // Infintely small (-1000 is an impossible value)
-    int v = -1000;
+    // The search plays its moves on one position, counting the pieces on every line once here
+    Position work = to_position(board);
+    return max_search(work, alpha, beta);
+}
+
+// Vector adapters for the bitboard searches above
+int min_value(const vector<vector<char> > &board) {
+    return min_value(to_bitboard(board), -1000, 1000);
+}
+
+int max_value(const vector<vector<char> > &board) {
+    return max_value(to_bitboard(board), -1000, 1000);
+}
+
+static int search_root(const Bitboard &bits, char AI);
+
+// Returns optimal move from the solved table, searching only if the table can't answer
+pair<int, int> minimax(const vector<vector<char> > &board, char AI) {
+    int cell = minimax_cell(to_bitboard(board), AI);
+    pair<int, int> location = {cell / SIZE, cell % SIZE};
+    return location;
+}
+
+// Bitboard version of minimax()
+int minimax_cell(const Bitboard &board, char AI) {
+    // The table only covers the standard 3x3 game, and only stores the move of the player whose turn it is
+    if (SIZE == 3 && WIN_LENGTH == 3 && AI == player(board) && !terminal(board)) {
+        // Nothing was searched
+        long long start = now_ns();
+        int cell = perfect_move(board);
+        last_stats = {0, 0, 0, 0, now_ns() - start, 0};
+        return cell;
+    }
+
+    // Larger boards use the tablebase when one was opened for them (one lookup, nothing searched)
+    long long start = now_ns();
+    int value;
+    int cell;
+    if (AI == player(board) && tablebase_probe(board, value, cell) && cell >= 0) {
+        last_stats = {0, 0, 0, 0, now_ns() - start, 0};
+        return cell;
+    }
+
+    return search_root(board, AI);
+}
+
+// Returns a random empty cell
+int random_cell(const Bitboard &board, mt19937 &rng) {
+    MoveList moves;
+    legal_moves(board, moves);
+    return moves.cells[rng() % moves.count];
+}
+
+// Chance (in percent) of a random move for each difficulty, indexed by the difficulty char.
+// Defaults: Random 100%, everything else 0% (Easy and Normal sample from the analysis instead, see move_temperature()).
+// The table is built once, before its first use returns, even if the first uses come from several AI threads at once.
+static array<int, 128> &random_chances() {
+    static array<int, 128> chances = []() {
+        array<int, 128> defaults = {};
+        defaults['R'] = 100;
+        return defaults;
+    }();
+    return chances;
+}
+
+int random_move_chance(char difficulty) {
+    return random_chances()[difficulty & 127];
+}
+
+void set_random_move_chance(char difficulty, int percent) {
+    random_chances()[difficulty & 127] = percent;
+}
+
+// Deepest anytime search of each level: Easy looks one ply ahead, Normal two, every other level as deep as its
+// budget allows
+static int anytime_depth(char difficulty) {
+    if (difficulty == 'E') {
+        return 1;
+    }
+    if (difficulty == 'N') {
+        return 2;
+    }
+    return 0;
+}
+
+// Roll against the difficulty's chance of a random move
+int ai_cell(const Bitboard &board, char AI, char difficulty, mt19937 &rng, Ponderer *ponderer) {
+    if ((int)(rng() % 100) < random_move_chance(difficulty)) {
+        // Nothing was searched (and whatever was pondered isn't needed)
+        long long start = now_ns();
+        if (ponderer != nullptr) {
+            ponderer->stop();
+        }
+        int cell = random_cell(board, rng);
+        last_stats = {0, 0, 0, 0, now_ns() - start, 0};
+        return cell;
+    }
+    
+    // A reply searched while the human was thinking (the stats keep its nodes, but the time is only the wait).
+    // Levels with a temperature on boards searched to the end sample from the root analysis instead (see below).
+    if (ponderer != nullptr) {
+        long long start = now_ns();
+        int cell;
+        SearchStats pondered;
+        bool usable = ai_backend(difficulty) == BACKEND_MINIMAX
+                      && (anytime_board() || move_temperature(difficulty) <= 0);
+        bool ready = usable && ponderer->take(board, cell, pondered);
+        ponderer->stop();
+        if (ready) {
+            last_stats = pondered;
+            last_stats.wall_ns = now_ns() - start;
+            return cell;
+        }
+    }
     
-    // Mutual recursive backtracking with min_value
-    // Try out each action, return the maximum out of the other player's minimums
-    for (pair<int, int> action : actions(board)) {
-        v = max(v, min_value(result(board, action)));
+    // Boards too large to search to the end get a search that stops within the move budget
+    if (ai_backend(difficulty) == BACKEND_MINIMAX && anytime_board()) {
+        return large_board_cell(board, AI, difficulty);
     }
     
-    return v;
+    // Levels with a temperature sample from the scored root moves (the pondering only warmed the transposition table)
+    if (ai_backend(difficulty) == BACKEND_MINIMAX && move_temperature(difficulty) > 0) {
+        return softmax_cell(analyze_root(board), AI, move_temperature(difficulty), rng);
+    }
+    
+    // Monte Carlo Tree Search for levels that use it
+    if (ai_backend(difficulty) == BACKEND_MCTS) {
+        int cell = mcts_cell(board, AI);
+        MctsStats mcts = last_mcts_stats();
+        last_stats = {0, 0, 0, 0, mcts.wall_ns, mcts.playouts};
+        return cell;
+    }
+    return minimax_cell(board, AI);
 }
 
-// Returns optimal move
-pair<int, int> minimax(vector<vector<char> > board, char AI) {
+// Threat search, then the anytime search, sharing the move budget
+int large_board_cell(const Bitboard &board, char AI, char difficulty) {
+    long long start = now_ns();
+    AnytimeSettings budget = anytime_settings();
+    
+    // Levels without a depth limit first play or stop a forced win, within half the budget (at least a
+    // millisecond, since a time of 0 means no limit)
+    long long left_nodes = budget.nodes;
+    if (anytime_depth(difficulty) == 0 && threat_search()) {
+        long long threat_ms = (budget.time_ms > 0) ? max(1LL, budget.time_ms / 2) : 0;
+        long long threat_nodes = (budget.nodes > 0) ? max(1LL, budget.nodes / 2) : 0;
+        int cell = threat_cell(board, AI, threat_ms, threat_nodes);
+        if (cell >= 0) {
+            last_stats = {last_proof_stats().nodes, 0, 0, 0, now_ns() - start, 0};
+            return cell;
+        }
+        if (budget.nodes > 0) {
+            left_nodes = max(1LL, budget.nodes - threat_nodes);
+        }
+    }
+    
+    // The rest of the budget goes to the anytime search
+    long long left_ms = 0;
+    if (budget.time_ms > 0) {
+        left_ms = max(1LL, budget.time_ms - (now_ns() - start + 999999) / 1000000);
+    }
+    int cell = anytime_cell(board, AI, left_ms, left_nodes, anytime_depth(difficulty));
+    AnytimeStats anytime = last_anytime_stats();
+    last_stats = {anytime.nodes, 0, 0, 0, now_ns() - start, 0};
+    STATS(last_stats.max_depth = anytime.depth);
+    return cell;
+}
+
+// Engine of each difficulty, indexed by the difficulty char (BACKEND_MINIMAX unless changed)
+static AIBackend backends[128] = {BACKEND_MINIMAX};
+
+AIBackend ai_backend(char difficulty) {
+    return backends[difficulty & 127];
+}
+
+void set_ai_backend(char difficulty, AIBackend backend) {
+    backends[difficulty & 127] = backend;
+}
+
+// Search every root move on the search pool's threads and return the chosen cell.
+// Gives exactly the cell the serial loop in minimax_search() gives: the lowest cell with the best utility.
+static int parallel_root(const Bitboard &bits, char AI) {
+    // Root moves in the order they are handed out, most promising first so good bounds are found early
+    vector<int> cells;
+    BoardMask empty = empty_cells(bits);
+    for (int i = 0; i < geometry().cells; i++) {
+        if (has_cell(empty, geometry().move_order[i])) {
+            cells.push_back(geometry().move_order[i]);
+        }
+    }
+    
+    // Best move so far (shared by every worker) and the counters of every worker added up
+    mutex best_mutex;
+    int best_value = (AI == X) ? -1000 : 1000;
+    int best_cell = -1;
+    SearchStats total = SearchStats();
+    int win = (AI == X) ? 1 : -1;
+    
+    search_pool->run(cells.size(), [&](int task) {
+        int cell = cells[task];
+        
+        // Bound from the best move so far. It is an alpha for X and a beta for O.
+        int bound;
+        {
+            lock_guard<mutex> lock(best_mutex);
+            
+            // A win at a lower cell can't be beaten or tied
+            if (best_cell >= 0 && best_cell < cell && best_value == win) {
+                return;
+            }
+            
+            // A lower cell wins ties, so this move has to beat the best utility of the lower cells,
+            // but only has to tie the best utility of the higher cells
+            bound = best_value;
+            if (best_cell > cell) {
+                bound = (AI == X) ? best_value - 1 : best_value + 1;
+            }
+        }
+        
+        // Same search as the serial loop, with the shared bound as the window
+        reset_counters();
+        int value;
+        if (AI == X) {
+            value = min_value(result(bits, cell), bound, 1000);
+        }
+        else {
+            value = max_value(result(bits, cell), -1000, bound);
+        }
+        
+        lock_guard<mutex> lock(best_mutex);
+        collect_counters(total);
+        
+        // Only a utility beyond the bound is exact (anything else is a cutoff)
+        bool exact = (AI == X) ? value > bound : value < bound;
+        if (!exact) {
+            return;
+        }
+        bool better = (AI == X) ? value > best_value : value < best_value;
+        if (best_cell < 0 || better || (value == best_value && cell < best_cell)) {
+            best_value = value;
+            best_cell = cell;
+        }
+    });
+    
+    last_stats = total;
+    return best_cell;
+}
+
+#ifdef TICTACTOE_STATS
+// Turn the deepest ply of last_stats into the depth below the root bits (instead of pieces on the board)
+static void depth_below_root(const Bitboard &bits) {
+    last_stats.max_depth = max(0, last_stats.max_depth - count_cells(bits.x | bits.o));
+}
+#endif
+
+// Finish last_stats after a search that started at start (nanoseconds)
+static void finish_stats(long long start) {
+    last_stats.wall_ns = now_ns() - start;
+}
+
+// Returns optimal cell by searching
+static int search_root(const Bitboard &bits, char AI) {
+    long long start = now_ns();
+    
+    // Spread the root moves over several threads if there are any (the pool's threads can't see this thread's
+    // stop flag, so stoppable searches stay on this thread)
+    if (search_thread_count > 1 && search_stop == nullptr) {
+        int cell = parallel_root(bits, AI);
+        STATS(depth_below_root(bits));
+        finish_stats(start);
+        return cell;
+    }
+    
+    reset_counters();
+    
     // Set inital values and define variables
-    pair<int, int> optimalX;
-    pair<int, int> optimalO;
+    int optimalX = -1;
+    int optimalO = -1;
     
     // Infintely small (-1000 is an impossible value) so that first value will always be greater.
     int optimalX_util = -1000;
@@ -478,34 +1254,242 @@ pair<int, int> minimax(vector<vector<char> > board, char AI) {
     // Infintely large (1000 is an impossible value) so that first value will always be less.
     int optimalO_util = 1000;
     
-    // Iterate through every action
-    for (pair<int, int> action : actions(board)) {
+    // Iterate through every empty cell (lowest index first, same order as actions()).
+    // The root keeps this order, so ties are broken the same way as a full search would break them.
+    BoardMask empty = empty_cells(bits);
+    while (any_cell(empty) && !stop_requested()) {
+        int cell = pop_cell(empty);
         // If AI playing as X, look for action that yields the highest possible utility (score)
         if (AI == X) {
-            int max_value_action = min_value(result(board,action));
+            // Only a strictly higher utility can replace the current optimal action,
+            // so anything at or below it can be cut off
+            int max_value_action = min_value(result(bits, cell), optimalX_util, 1000);
             // Compare utility to current highest
             if (max_value_action > optimalX_util) {
                 optimalX_util = max_value_action;
-                optimalX = action;
+                optimalX = cell;
             }
             
+            // A win can't be beaten
+            if (optimalX_util == 1) {
+                break;
+            }
         }
         // If AI playing as O, look for action that yields the lowest possible utility 
         else {
-            int min_value_action = max_value(result(board,action));
+            int min_value_action = max_value(result(bits, cell), -1000, optimalO_util);
             // Compare utility to current lowest
             if (min_value_action < optimalO_util) {
                 optimalO_util = min_value_action;
-                optimalO = action;
+                optimalO = cell;
+            }
+            
+            // A win can't be beaten
+            if (optimalO_util == -1) {
+                break;
             }
         }
     }
     
+    last_stats = SearchStats();
+    collect_counters(last_stats);
+    STATS(depth_below_root(bits));
+    finish_stats(start);
+    
     // Return the move that corresponds to the player the AI is playing as
-    if (AI == X) {
-        return optimalX;
+    return (AI == X) ? optimalX : optimalO;
+}
+
+// Returns optimal move by searching
+pair<int, int> minimax_search(const vector<vector<char> > &board, char AI) {
+    // Search on the bitboard instead of the 2D vector
+    int cell = search_root(to_bitboard(board), AI);
+    pair<int, int> location = {cell / SIZE, cell % SIZE};
+    return location;
+}
+
+// Statistics of the most recent search
+SearchStats last_search_stats() {
+    return last_stats;
+}
+
+// Start a new pool whenever the number of threads changes
+void set_search_threads(int threads) {
+    if (threads < 1) {
+        threads = 1;
+    }
+    search_thread_count = threads;
+    
+    if (threads > 1) {
+        search_pool.reset(new ThreadPool(threads));
     }
     else {
-        return optimalO;
+        search_pool.reset();
     }
-}
\ No newline at end of file
+}
+
+int search_threads() {
+    return search_thread_count;
+}
+
+void set_search_stop(const atomic<bool> *stop) {
+    search_stop = stop;
+}
+
+// Value and best move from the solved table or the tablebase, if one of them covers the board
+static bool table_answer(const Bitboard &board, int &value, int &cell) {
+    if (SIZE == 3 && WIN_LENGTH == 3) {
+        value = perfect_value(board);
+        cell = perfect_move(board);
+        return true;
+    }
+    return tablebase_probe(board, value, cell) && cell >= 0;
+}
+
+// Exact utility of a position: a table lookup if one applies, otherwise a full-window search
+static int exact_value(const Bitboard &board) {
+    if (terminal(board)) {
+        return utility(board);
+    }
+    int value;
+    int cell;
+    if (table_answer(board, value, cell)) {
+        return value;
+    }
+    return (player(board) == X) ? max_value(board, -1000, 1000) : min_value(board, -1000, 1000);
+}
+
+// Plies until the game ends from a position with the given exact value, along the line the engine plays:
+// the table's move, or else the first move in the geometry's move order that keeps the value
+static int plies_to_end(Bitboard board, int value) {
+    int plies = 0;
+    while (!terminal(board)) {
+        int cell = -1;
+        int table_value;
+        if (!table_answer(board, table_value, cell)) {
+            const Geometry &g = geometry();
+            BoardMask empty = empty_cells(board);
+            for (int i = 0; i < g.cells && cell < 0; i++) {
+                int move = g.move_order[i];
+                if (has_cell(empty, move) && exact_value(result(board, move)) == value) {
+                    cell = move;
+                }
+            }
+        }
+        if (cell < 0) {
+            break;
+        }
+        make_move(board, cell, player(board));
+        plies++;
+    }
+    return plies;
+}
+
+// Score one root move (the counters of this thread are reset first)
+static MoveScore score_move(const Bitboard &bits, int cell) {
+    reset_counters();
+    Bitboard child = result(bits, cell);
+    MoveScore score;
+    score.cell = cell;
+    score.value = exact_value(child);
+    score.depth = 1 + plies_to_end(child, score.value);
+    
+    SearchStats counters = SearchStats();
+    collect_counters(counters);
+    score.nodes = counters.nodes;
+    return score;
+}
+
+// Last analysis on this thread, reused while the same position of the same geometry is asked for
+static thread_local Bitboard analyzed_board = {BoardMask(), BoardMask()};
+static thread_local int analyzed_size = 0;
+static thread_local int analyzed_win = 0;
+static thread_local vector<MoveScore> analyzed_moves;
+
+vector<MoveScore> analyze_root(const Bitboard &board) {
+    long long start = now_ns();
+    
+    // Same position as last time: nothing is searched
+    bool cached = analyzed_size == SIZE && analyzed_win == WIN_LENGTH &&
+                  analyzed_board.x == board.x && analyzed_board.o == board.o;
+    if (cached) {
+        last_stats = {0, 0, 0, 0, now_ns() - start, 0};
+        return analyzed_moves;
+    }
+    
+    // Root moves in row-major order, like the root of the search
+    vector<int> cells;
+    BoardMask empty = empty_cells(board);
+    while (any_cell(empty)) {
+        cells.push_back(pop_cell(empty));
+    }
+    vector<MoveScore> moves(cells.size());
+    last_stats = SearchStats();
+    
+    // Every move is searched with a full window, so the moves are independent and can go to the search pool
+    if (search_thread_count > 1 && search_stop == nullptr) {
+        mutex stats_mutex;
+        search_pool->run(cells.size(), [&](int task) {
+            moves[task] = score_move(board, cells[task]);
+            lock_guard<mutex> lock(stats_mutex);
+            collect_counters(last_stats);
+        });
+    }
+    else {
+        for (size_t i = 0; i < cells.size(); i++) {
+            moves[i] = score_move(board, cells[i]);
+            collect_counters(last_stats);
+        }
+    }
+    STATS(depth_below_root(board));
+    finish_stats(start);
+    
+    analyzed_board = board;
+    analyzed_size = SIZE;
+    analyzed_win = WIN_LENGTH;
+    analyzed_moves = moves;
+    return moves;
+}
+
+// Sample a move with weights exp(score / temperature), shifted by the best score so the weights can't overflow
+int softmax_cell(const vector<MoveScore> &moves, char mover, double temperature, mt19937 &rng) {
+    // Scores from the mover's side; the first best move is the one minimax() would play
+    vector<int> scores(moves.size());
+    int best = 0;
+    for (size_t i = 0; i < moves.size(); i++) {
+        scores[i] = (mover == X) ? moves[i].value : -moves[i].value;
+        if (scores[i] > scores[best]) {
+            best = i;
+        }
+    }
+    if (temperature <= 0) {
+        return moves[best].cell;
+    }
+    
+    vector<double> weights(moves.size());
+    for (size_t i = 0; i < moves.size(); i++) {
+        weights[i] = exp((scores[i] - scores[best]) / temperature);
+    }
+    discrete_distribution<int> pick(weights.begin(), weights.end());
+    return moves[pick(rng)].cell;
+}
+
+// Softmax temperature of each difficulty, indexed by the difficulty char (0 plays the best move).
+// Defaults: Easy 1.0, Normal 0.35, everything else 0. Built once, like random_chances().
+static array<double, 128> &temperatures() {
+    static array<double, 128> table = []() {
+        array<double, 128> defaults = {};
+        defaults['E'] = 1.0;
+        defaults['N'] = 0.35;
+        return defaults;
+    }();
+    return table;
+}
+
+double move_temperature(char difficulty) {
+    return temperatures()[difficulty & 127];
+}
+
+void set_move_temperature(char difficulty, double temperature) {
+    temperatures()[difficulty & 127] = temperature;
+}
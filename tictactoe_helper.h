@@ -16,13 +16,19 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <random>
+#include "bitboard.h"
+#include <atomic>
 
 using namespace std;
 
 // Note: Extern keyword is used here to share access to the following consts (these are defined in 'tictactoe_helper.cpp')
 
-// Size of tictactoe grid
-extern const int SIZE;
+// Size of tictactoe grid (3 unless changed with set_board_size(), see 'bitboard.h')
+extern int SIZE;
+
+// Number of pieces in a row needed to win (3 unless changed with set_board_size())
+extern int WIN_LENGTH;
 
 // Character that repersents X
 extern const char X;
@@ -34,6 +40,8 @@ extern const char O;
  * Function: run_game()
  * Description: Runs the game loop, including tasks like rendering the game frame, flushing previous frames, 
  *              indicating invalid inputs to players, and indicating terminal states.
+ *              Frames are drawn with a Renderer (see 'renderer.h'), so only the parts that changed are redrawn.
+ *              The finished game is added to the game record, if one is set (see 'game_record.h').
  * Parameter(s): 
  *     human: char repersenting which player the human is.
  *     AI: char repersenting which player the AI is.
@@ -58,17 +66,28 @@ pair<char, char> choose_player();
  * Parameter(s): 
  *     input: coordinate input in the form of a string.
  * Returns: Pair of numbers; .first repersents x, .second repersents y.
+ *          Returns {-1, -1} as a sentinel value if there is no comma or the coordinates are outside the grid.
  */
 pair<int, int> parse_input(string input);
 
 /*
  * Function: render_board()
- * Description: Renders the board grid 
+ * Description: Renders the board grid (indicators are padded so grids larger than 10x10 stay aligned).
+ *              The whole grid is written to cout at once.
  * Parameter(s): 
  *     board: 2D vector of chars repersenting the board.
  * Returns: void.
  */
-void render_board(vector<vector<char> > board);
+void render_board(const vector<vector<char> > &board);
+
+/*
+ * Function: board_lines()
+ * Description: Returns the lines render_board() prints (indicator row first, then one line per row of the grid).
+ * Parameter(s): 
+ *     board: 2D vector of chars repersenting the board.
+ * Returns: Vector of lines without newlines.
+ */
+vector<string> board_lines(const vector<vector<char> > &board);
 
 /*
  * Function: empty_board()
@@ -87,7 +106,7 @@ vector<vector<char> > empty_board();
  *     board: 2D vector of chars repersenting the board.
  * Returns: Boolean value; true if game is over, false otherwise.
  */
-bool terminal(vector<vector<char> > &board);
+bool terminal(const vector<vector<char> > &board);
 
 /*
  * Function: player()
@@ -96,7 +115,7 @@ bool terminal(vector<vector<char> > &board);
  *     board: 2D vector of chars repersenting the board.
  * Returns: Char repersenting which player has the current turn.
  */
-char player(vector<vector<char> > board);
+char player(const vector<vector<char> > &board);
 
 /*
  * Function: winner()
@@ -105,7 +124,7 @@ char player(vector<vector<char> > board);
  *     board: 2D vector of chars repersenting the board.
  * Returns: Char repersenting which player has won. Returns ' ' as a sentinel value if no player has won.
  */
-char winner(vector<vector<char> > &board);
+char winner(const vector<vector<char> > &board);
 
 /*
  * Function: utility()
@@ -114,7 +133,7 @@ char winner(vector<vector<char> > &board);
  *     board: 2D vector of chars repersenting the board.
  * Returns: Integer type; 1 if X wins, -1 if O wins, 0 if tied.
  */
-int utility(vector<vector<char> > board);
+int utility(const vector<vector<char> > &board);
 
 /*
  * Function: actions()
@@ -124,7 +143,7 @@ int utility(vector<vector<char> > board);
  * Returns: Set of coordinates (type pair<int,int>) repersenting available actions. 
  *          Set type is used to ensure there are no duplicates.
  */
-set<pair<int, int> > actions(vector<vector<char> > &board);
+set<pair<int, int> > actions(const vector<vector<char> > &board);
 
 /*
  * Function: update()
@@ -147,17 +166,31 @@ void update(vector<vector<char> > &board, pair<int, int> location, char team);
  *     team: The team (X or O) that the function should place at the location.
  * Returns: 2D vector of chars repersenting the board.
  */
-vector<vector<char> > result(vector<vector<char> > board, pair<int, int> location);
+vector<vector<char> > result(const vector<vector<char> > &board, pair<int, int> location);
 
 /*
  * Function: min_value()
  * Description: Calculates the minimum possible utility (see utility function) of a board given optimal play.
  *              This is done using mutual recursive backtracking with max_value. 
+ *              Results are cached in the shared transposition table, so it should only be called when O is to move.
  * Parameter(s): 
  *     board: 2D vector of chars repersenting the board.
  * Returns: Minimum possible utility of a board.
  */
-int min_value(vector<vector<char> > board);
+int min_value(const vector<vector<char> > &board);
+
+/*
+ * Function: min_value()
+ * Description: Bitboard version of min_value() above; the vector version converts the board and calls this one.
+ *              Uses alpha-beta pruning: once the result is known to be at or below alpha, or at or above beta,
+ *              the search stops and returns a bound instead of the exact utility.
+ * Parameter(s): 
+ *     board: Bitboard repersenting the board.
+ *     alpha: Score X is already guaranteed elsewhere (-1000 for none).
+ *     beta: Score O is already guaranteed elsewhere (1000 for none).
+ * Returns: Minimum possible utility of a board (exact if it lies strictly between alpha and beta).
+ */
+int min_value(const Bitboard &board, int alpha, int beta);
 
 /*
  * Function: random_move()
@@ -166,28 +199,294 @@ int min_value(vector<vector<char> > board);
  *     board: 2D vector of chars repersenting the board.
  * Returns: Coordinates; the location of the random move.
  */
-pair<int, int> random_move(vector<vector<char> > &board);
+pair<int, int> random_move(const vector<vector<char> > &board);
 
 /*
  * Function: max_value()
  * Description: Calculates the maximum possible utility (see utility function) of a board given optimal play.
  *              This is done using mutual recursive backtracking with min_value. 
+ *              Results are cached in the shared transposition table, so it should only be called when X is to move.
  * Parameter(s): 
  *     board: 2D vector of chars repersenting the board.
  * Returns: Maximum possible utility of a board.
  */
-int max_value(vector<vector<char> > board);
+int max_value(const vector<vector<char> > &board);
+
+/*
+ * Function: max_value()
+ * Description: Bitboard version of max_value() above; the vector version converts the board and calls this one.
+ *              Uses alpha-beta pruning like min_value().
+ * Parameter(s): 
+ *     board: Bitboard repersenting the board.
+ *     alpha: Score X is already guaranteed elsewhere (-1000 for none).
+ *     beta: Score O is already guaranteed elsewhere (1000 for none).
+ * Returns: Maximum possible utility of a board (exact if it lies strictly between alpha and beta).
+ */
+int max_value(const Bitboard &board, int alpha, int beta);
 
 /*
  * Function: minimax()
  * Description: Returns the optimal move for the AI. 
+ *              The answer is a single lookup in the table of solved positions generated at compile time
+ *              (see 'perfect_table.h'). If the table can't answer (it isn't the AI's turn), it falls back to
+ *              the tablebase if one is open for the board (see 'tablebase.h'), then to minimax_search().
+ * Parameter(s): 
+ *     board: 2D vector of chars repersenting the board.
+ *     AI: Char repersenting which player the AI is.
+ * Returns: Optimal move for the AI.
+ */
+pair<int, int> minimax(const vector<vector<char> > &board, char AI);
+
+/*
+ * Function: minimax_search()
+ * Description: Returns the optimal move for the AI by searching the game tree. 
  *              It does this by looping over all possible actions and choosing the action with the minimum/Maximum
  *              possible utility, depending on which player the AI is. It calls min_value() and max_value() to do so.
+ *              The search itself runs on a Bitboard (see 'bitboard.h'); the vector board is only converted once.
+ *              Solved positions are kept in the shared transposition table (see 'transposition.h').
+ *              Below the root, moves are tried center first, then corners, then edges (after the table's best move
+ *              and the killer move of that ply) and pruned with alpha-beta. The root still tries moves in row-major
+ *              order, so the chosen move is the same as with a full search.
+ *              With more than one search thread (see set_search_threads()) the root moves are searched in
+ *              parallel; the threads share the best move so far as their bound, and the result is the same move.
  * Parameter(s): 
  *     board: 2D vector of chars repersenting the board.
  *     AI: Char repersenting which player the AI is.
  * Returns: Optimal move for the AI.
  */
-pair<int, int> minimax(vector<vector<char> > board, char AI);
+pair<int, int> minimax_search(const vector<vector<char> > &board, char AI);
+
+/*
+ * Function: minimax_cell()
+ * Description: Bitboard version of minimax(): the solved table or the tablebase if one applies, otherwise a search.
+ * Parameter(s): 
+ *     board: Bitboard of the position.
+ *     AI: Char repersenting which player the AI is.
+ * Returns: Cell index (row * SIZE + column) of the optimal move.
+ */
+int minimax_cell(const Bitboard &board, char AI);
+
+/*
+ * Function: random_cell()
+ * Description: Returns a random empty cell.
+ * Parameter(s): 
+ *     board: Bitboard of the position (must have an empty cell).
+ *     rng: Random number generator to draw from.
+ * Returns: Cell index of a random empty cell.
+ */
+int random_cell(const Bitboard &board, mt19937 &rng);
+
+/*
+ * Function: random_move_chance()
+ * Description: Returns the chance that a difficulty level plays a random move instead of the optimal one.
+ *              The default is 100% for Random ('R') and 0% for every other level (Easy and Normal are weakened
+ *              with a temperature instead, see move_temperature()).
+ * Parameter(s): 
+ *     difficulty: Char repersenting the difficulty level.
+ * Returns: Chance of a random move in percent (0 to 100).
+ */
+int random_move_chance(char difficulty);
+
+/*
+ * Function: set_random_move_chance()
+ * Description: Changes the chance of a random move for one difficulty level (used to calibrate the levels).
+ * Parameter(s): 
+ *     difficulty: Char repersenting the difficulty level.
+ *     percent: Chance of a random move in percent (0 to 100).
+ * Returns: Void.
+ */
+void set_random_move_chance(char difficulty, int percent);
+
+// Background search of the AI's replies (see 'ponder.h')
+class Ponderer;
+
+/*
+ * Function: ai_cell()
+ * Description: Returns the AI's move at a difficulty level: a random move with the level's chance
+ *              (see random_move_chance()), otherwise the move of the level's backend (see ai_backend()).
+ *              Minimax levels with a temperature sample from the scored root moves (see softmax_cell()).
+ *              On boards too large to search to the end (see anytime_board() in 'anytime.h'), minimax levels
+ *              use anytime_cell() within its move budget instead: Easy 1 ply deep, Normal 2, others unlimited.
+ *              The unlimited levels first spend up to half the budget on threat_cell() (see 'proof_search.h'),
+ *              so they play a forced win and stop the opponent's whenever it finds them.
+ *              If a ponderer searched the position during the opponent's turn, its reply is used instead
+ *              of searching again (on large boards too); either way the ponderer is stopped.
+ *              last_search_stats() reports 0 nodes after a random move.
+ * Parameter(s): 
+ *     board: Bitboard of the position (must not be terminal).
+ *     AI: Char repersenting which player the AI is.
+ *     difficulty: Char repersenting the difficulty level.
+ *     rng: Random number generator to draw from.
+ *     ponderer: Ponderer started at the opponent's turn, or nullptr.
+ * Returns: Cell index of the AI's move.
+ */
+int ai_cell(const Bitboard &board, char AI, char difficulty, mt19937 &rng, Ponderer *ponderer = nullptr);
+
+/*
+ * Function: large_board_cell()
+ * Description: Returns the move a minimax level plays on a board too large to search to the end (see ai_cell()):
+ *              threat_cell() for the unlimited levels, then anytime_cell(), within the move budget of
+ *              anytime_settings(). Sets last_search_stats(). The searches stop early if told to (see
+ *              set_search_stop()), and the move is meaningless then.
+ * Parameter(s): 
+ *     board: Bitboard of the position (must not be terminal).
+ *     AI: Char repersenting which player the AI is.
+ *     difficulty: Char repersenting the difficulty level.
+ * Returns: Cell index of the AI's move.
+ */
+int large_board_cell(const Bitboard &board, char AI, char difficulty);
+
+// Engines the AI can use for its non-random moves
+enum AIBackend {
+    // minimax_cell(): the solved table or an exhaustive search (anytime_cell() on large boards)
+    BACKEND_MINIMAX,
+    
+    // mcts_cell(): Monte Carlo Tree Search within the MCTS budget (see 'mcts.h')
+    BACKEND_MCTS
+};
+
+/*
+ * Function: ai_backend() / set_ai_backend()
+ * Description: Read or change the engine a difficulty level uses (every level uses BACKEND_MINIMAX by default).
+ * Parameter(s): 
+ *     difficulty: Char repersenting the difficulty level.
+ *     backend: Engine to use.
+ */
+AIBackend ai_backend(char difficulty);
+void set_ai_backend(char difficulty, AIBackend backend);
+
+// Statistics of a minimax() or minimax_search() call
+struct SearchStats {
+    // Number of positions visited (including terminal ones and table hits)
+    long long nodes;
+    
+    // Only counted when compiled with -DTICTACTOE_STATS (always 0 otherwise, so the search pays nothing for them):
+    // positions that were won or full, positions settled by the transposition table, and the deepest ply searched
+    // below the root
+    long long terminals;
+    long long cache_hits;
+    int max_depth;
+    
+    // Wall time of the call in nanoseconds
+    long long wall_ns;
+    
+    // Playouts run when the move came from Monte Carlo Tree Search (see 'mcts.h'), 0 otherwise
+    long long playouts;
+};
+
+// True if the search was compiled with the extra counters of SearchStats
+#ifdef TICTACTOE_STATS
+const bool SEARCH_STATS_ENABLED = true;
+#else
+const bool SEARCH_STATS_ENABLED = false;
+#endif
+
+/*
+ * Function: last_search_stats()
+ * Description: Returns the statistics of the most recent minimax() or minimax_search() call on this thread
+ *              (also minimax_cell() and ai_cell(); random moves and table answers count 0 nodes).
+ * Parameter(s): 
+ * Returns: SearchStats of the last search.
+ */
+SearchStats last_search_stats();
+
+/*
+ * Function: set_search_threads()
+ * Description: Sets how many threads minimax_search() uses (1 searches on the calling thread only).
+ *              Must not be called while a search is running.
+ * Parameter(s): 
+ *     threads: Number of search threads.
+ * Returns: Void.
+ */
+void set_search_threads(int threads);
+
+/*
+ * Function: search_threads()
+ * Description: Returns how many threads minimax_search() uses.
+ * Parameter(s): 
+ * Returns: Number of search threads.
+ */
+int search_threads();
+
+/*
+ * Function: set_search_stop()
+ * Description: Makes the searches on the calling thread stoppable: once *stop becomes true, a running search
+ *              returns as soon as possible with a meaningless move, and stores nothing it hadn't finished in
+ *              the transposition table. Stoppable searches run on the calling thread only.
+ * Parameter(s): 
+ *     stop: Flag to watch (nullptr makes the searches of this thread unstoppable again).
+ * Returns: Void.
+ */
+void set_search_stop(const atomic<bool> *stop);
+
+/*
+ * Function: search_stop_requested()
+ * Description: Checks the flag set with set_search_stop() on the calling thread, for searches in other files
+ *              (see 'anytime.h' and 'proof_search.h') that stop the same way.
+ * Parameter(s): 
+ * Returns: Boolean value; true if the searches of this thread have been told to stop.
+ */
+bool search_stop_requested();
+
+/*
+ * Function: set_fixed_search() / fixed_search_available()
+ * Description: Turn the searches compiled for fixed board sizes on or off (on by default), and check whether the
+ *              current board has one. They exist for 3x3 (3 in a row), 4x4 (3 or 4) and 5x5 (3, 4 or 5), see
+ *              'fixed_board.h'. They give the same values, moves and node counts as the generic search, faster.
+ *              Must not be called while a search is running.
+ */
+void set_fixed_search(bool enabled);
+bool fixed_search_available();
+
+// One root move scored by analyze_root()
+struct MoveScore {
+    // Cell index of the move
+    int cell;
+    
+    // Utility after the move with both players playing optimally (1 if X wins, -1 if O wins, 0 if tied)
+    int value;
+    
+    // Plies until the game ends, counting the move itself, along the line the engine would play
+    int depth;
+    
+    // Positions visited to score the move (0 when a table answered)
+    long long nodes;
+};
+
+/*
+ * Function: analyze_root()
+ * Description: Scores every legal move of a position once, each with an exact (full-window) search, or with the
+ *              solved table or tablebase when one applies. The moves are spread over the search threads like
+ *              minimax_search(). The last analysis on each thread is kept, so asking again for the same position
+ *              (for a hint, then for the move) searches nothing. last_search_stats() reports the whole analysis.
+ * Parameter(s): 
+ *     board: Bitboard of the position (must not be terminal).
+ * Returns: Vector of every legal move with its score, in row-major order.
+ */
+vector<MoveScore> analyze_root(const Bitboard &board);
+
+/*
+ * Function: softmax_cell()
+ * Description: Picks a move from an analysis: each move has weight exp(score / temperature), where the score is
+ *              the move's value from the mover's side. Higher temperatures play weaker moves more often.
+ * Parameter(s): 
+ *     moves: Scored moves (see analyze_root()).
+ *     mover: Char repersenting the player to move.
+ *     temperature: Softmax temperature; 0 or less always plays the first best move (the move minimax() plays).
+ *     rng: Random number generator to draw from.
+ * Returns: Cell index of the chosen move.
+ */
+int softmax_cell(const vector<MoveScore> &moves, char mover, double temperature, mt19937 &rng);
+
+/*
+ * Function: move_temperature() / set_move_temperature()
+ * Description: Read or change the softmax temperature of a difficulty level (see softmax_cell()). The defaults are
+ *              1.0 for Easy ('E'), 0.35 for Normal ('N') and 0 for every other level (no sampling).
+ * Parameter(s): 
+ *     difficulty: Char repersenting the difficulty level.
+ *     temperature: Softmax temperature (0 turns sampling off).
+ */
+double move_temperature(char difficulty);
+void set_move_temperature(char difficulty, double temperature);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,336 @@
+/*
+ * File: tournament.cpp
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * This file defines the functions declared in 'tournament.h'.
+ * Notes:
+ * Comments in this file are implementation level.
+ * More details regarding the purpose and use of each function can be found in 'tournament.h'.
+ */
+
+#include "tournament.h"
+#include "tictactoe_helper.h"
+#include "transposition.h"
+#include "thread_pool.h"
+#include "mcts.h"
+#include "anytime.h"
+#include "histogram.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <map>
+#include <random>
+#include <time.h>
+
+// CPU time of the calling thread in nanoseconds (time spent waiting, for example for the playout pool, isn't counted)
+static long long thread_cpu_ns() {
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+bool parse_engine(const string &spec, EngineConfig &engine) {
+    engine.name = spec;
+    engine.level = 0;
+    engine.temperature = 0;
+    engine.playouts = 0;
+    engine.time_ms = 0;
+
+    // A single letter is a difficulty level
+    if (spec.size() == 1 && isalpha(spec[0])) {
+        engine.kind = ENGINE_LEVEL;
+        engine.level = toupper(spec[0]);
+        return true;
+    }
+
+    size_t colon = spec.find(':');
+    if (colon == string::npos || colon + 1 == spec.size()) {
+        return false;
+    }
+    string kind = spec.substr(0, colon);
+    string budget = spec.substr(colon + 1);
+
+    if (kind == "softmax") {
+        engine.kind = ENGINE_SOFTMAX;
+        engine.temperature = atof(budget.c_str());
+        return engine.temperature >= 0;
+    }
+    if (kind == "mcts" || kind == "anytime") {
+        engine.kind = (kind == "mcts") ? ENGINE_MCTS : ENGINE_ANYTIME;
+        // "20ms" is a time budget, a plain number a playout (or node) budget
+        if (budget.size() > 2 && budget.compare(budget.size() - 2, 2, "ms") == 0) {
+            engine.time_ms = atoll(budget.c_str());
+            return engine.time_ms > 0;
+        }
+        engine.playouts = atoll(budget.c_str());
+        return engine.playouts > 0;
+    }
+    return false;
+}
+
+// Breadth-first from the empty board, keeping one position per canonical key
+vector<Bitboard> opening_positions(int plies) {
+    Bitboard empty = {BoardMask(), BoardMask()};
+    vector<Bitboard> level = {empty};
+    for (int ply = 0; ply < plies; ply++) {
+        // The map orders the positions by key, so the openings don't depend on the order they were found in
+        map<uint64_t, Bitboard> next;
+        for (size_t i = 0; i < level.size(); i++) {
+            BoardMask cells = empty_cells(level[i]);
+            while (any_cell(cells)) {
+                Bitboard child = result(level[i], pop_cell(cells));
+                if (terminal(child)) {
+                    continue;
+                }
+                int symmetry;
+                next[canonical_key(child, symmetry)] = child;
+            }
+        }
+        level.clear();
+        for (auto it = next.begin(); it != next.end(); ++it) {
+            level.push_back(it->second);
+        }
+    }
+    return level;
+}
+
+// One game of the tournament
+struct GameJob {
+    int x_engine;
+    int o_engine;
+    int opening;
+};
+
+// Totals of one worker, merged at the end
+struct TournamentTotals {
+    vector<EngineStanding> standings;
+    vector<vector<double> > points;
+    vector<vector<long long> > games;
+};
+
+static TournamentTotals empty_totals(int engines) {
+    TournamentTotals totals;
+    EngineStanding zero = {0, 0, 0, 0, 0, 0, 0, 0};
+    totals.standings.assign(engines, zero);
+    totals.points.assign(engines, vector<double>(engines, 0));
+    totals.games.assign(engines, vector<long long>(engines, 0));
+    return totals;
+}
+
+// Move of an engine, adding the nodes it took to nodes. An MCTS engine searches its own tree with playouts seeded
+// from the game's generator, so the games don't depend on how they are spread over the workers.
+static int engine_cell(const EngineConfig &engine, const Bitboard &board, char turn, mt19937 &rng, MctsTree &tree,
+                       long long &nodes) {
+    int cell;
+    if (engine.kind == ENGINE_MCTS) {
+        uint64_t seed = ((uint64_t)rng() << 32) | rng();
+        cell = mcts_cell(board, turn, engine.playouts, engine.time_ms, tree, seed);
+        nodes += last_mcts_stats().playouts;
+        return cell;
+    }
+    if (engine.kind == ENGINE_ANYTIME) {
+        cell = anytime_cell(board, turn, engine.time_ms, engine.playouts, 0);
+        nodes += last_anytime_stats().nodes;
+        return cell;
+    }
+    if (engine.kind == ENGINE_SOFTMAX) {
+        cell = softmax_cell(analyze_root(board), turn, engine.temperature, rng);
+    }
+    else {
+        cell = ai_cell(board, turn, engine.level, rng);
+    }
+    nodes += last_search_stats().nodes + last_search_stats().playouts;
+    return cell;
+}
+
+// Play one game from its opening and add it to the totals. trees holds one MCTS tree per engine; they start
+// the game empty.
+static void play_game(const vector<EngineConfig> &engines, const GameJob &job, const Bitboard &opening, mt19937 &rng,
+                      vector<MctsTree> &trees, TournamentTotals &totals) {
+    trees[job.x_engine].clear();
+    trees[job.o_engine].clear();
+    Position position = to_position(opening);
+    while (!terminal(position)) {
+        char turn = player(position);
+        int index = (turn == X) ? job.x_engine : job.o_engine;
+        EngineStanding &standing = totals.standings[index];
+
+        long long start = thread_cpu_ns();
+        int cell = engine_cell(engines[index], position.board, turn, rng, trees[index], standing.nodes);
+        standing.cpu_ns += thread_cpu_ns() - start;
+        standing.moves++;
+
+        make_move(position, cell, turn);
+    }
+
+    // Points for each side (1 for a win, 0.5 for a draw)
+    char won = winner(position);
+    double x_points = (won == X) ? 1 : (won == O) ? 0 : 0.5;
+    int x = job.x_engine;
+    int o = job.o_engine;
+    totals.points[x][o] += x_points;
+    totals.points[o][x] += 1 - x_points;
+    totals.games[x][o]++;
+    totals.games[o][x]++;
+
+    EngineStanding &x_standing = totals.standings[x];
+    EngineStanding &o_standing = totals.standings[o];
+    x_standing.games++;
+    o_standing.games++;
+    if (won == X) {
+        x_standing.wins++;
+        o_standing.losses++;
+    }
+    else if (won == O) {
+        o_standing.wins++;
+        x_standing.losses++;
+    }
+    else {
+        x_standing.draws++;
+        o_standing.draws++;
+    }
+}
+
+// Bradley-Terry strengths by minorization-maximization, as Elo. Every engine also gets one draw against a virtual
+// engine of strength 1 (Elo 0), so an engine that won or lost every game still gets a finite rating.
+static vector<double> fit_elo(const vector<vector<double> > &points, const vector<vector<long long> > &games) {
+    int n = points.size();
+    vector<double> strength(n, 1.0);
+    for (int iteration = 0; iteration < 10000; iteration++) {
+        double change = 0;
+        for (int i = 0; i < n; i++) {
+            double score = 0.5;
+            double expected = 1.0 / (strength[i] + 1.0);
+            for (int j = 0; j < n; j++) {
+                score += points[i][j];
+                expected += games[i][j] / (strength[i] + strength[j]);
+            }
+            double updated = score / expected;
+            change = max(change, fabs(log(updated / strength[i])));
+            strength[i] = updated;
+        }
+        if (change < 1e-10) {
+            break;
+        }
+    }
+
+    // Relative to the average engine
+    vector<double> elo(n);
+    double total = 0;
+    for (int i = 0; i < n; i++) {
+        elo[i] = 400.0 * log10(strength[i]);
+        total += elo[i];
+    }
+    for (int i = 0; i < n; i++) {
+        elo[i] -= total / n;
+    }
+    return elo;
+}
+
+TournamentResult run_tournament(const vector<EngineConfig> &engines, int rounds, int opening_plies, int workers,
+                                unsigned seed) {
+    if (workers < 1) {
+        workers = 1;
+    }
+    int n = engines.size();
+    vector<Bitboard> openings = opening_positions(opening_plies);
+
+    // Every pair, every opening, both colors, every round
+    vector<GameJob> jobs;
+    for (int round = 0; round < rounds; round++) {
+        for (int a = 0; a < n; a++) {
+            for (int b = a + 1; b < n; b++) {
+                for (int opening = 0; opening < (int)openings.size(); opening++) {
+                    jobs.push_back({a, b, opening});
+                    jobs.push_back({b, a, opening});
+                }
+            }
+        }
+    }
+
+    // Every worker already keeps a core busy, so the search itself stays on the worker
+    int previous_threads = search_threads();
+    set_search_threads(1);
+
+    long long start = now_ns();
+    TournamentTotals total = run_strided(workers, jobs.size(), empty_totals(n), [&](int) {
+        // One MCTS tree per engine, kept by the worker from game to game
+        return [&, trees = vector<MctsTree>(n)](long long game, TournamentTotals &totals) mutable {
+            seed_seq game_seed = {seed, (unsigned)game};
+            mt19937 rng(game_seed);
+            play_game(engines, jobs[game], openings[jobs[game].opening], rng, trees, totals);
+        };
+    }, [n](TournamentTotals &total, const TournamentTotals &part) {
+        for (int i = 0; i < n; i++) {
+            EngineStanding &sum = total.standings[i];
+            const EngineStanding &add = part.standings[i];
+            sum.games += add.games;
+            sum.wins += add.wins;
+            sum.draws += add.draws;
+            sum.losses += add.losses;
+            sum.moves += add.moves;
+            sum.cpu_ns += add.cpu_ns;
+            sum.nodes += add.nodes;
+            for (int j = 0; j < n; j++) {
+                total.points[i][j] += part.points[i][j];
+                total.games[i][j] += part.games[i][j];
+            }
+        }
+    });
+    TournamentResult result;
+    result.engines = engines;
+    result.seconds = (now_ns() - start) / 1e9;
+    set_search_threads(previous_threads);
+
+    vector<double> elo = fit_elo(total.points, total.games);
+    for (int i = 0; i < n; i++) {
+        total.standings[i].elo = elo[i];
+    }
+    result.standings = total.standings;
+    result.points = total.points;
+    result.games = total.games;
+    result.openings = openings.size();
+    result.total_games = jobs.size();
+    return result;
+}
+
+void print_tournament(ostream &out, const TournamentResult &result) {
+    int n = result.engines.size();
+    out << fixed << setprecision(2);
+    out << "Tournament: " << n << " engines, " << result.openings << " openings, " << result.total_games
+        << " games on " << SIZE << "x" << SIZE << " (" << WIN_LENGTH << " in a row), " << result.seconds << " s"
+        << endl;
+
+    // Strongest first
+    vector<int> order(n);
+    for (int i = 0; i < n; i++) {
+        order[i] = i;
+    }
+    stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return result.standings[a].elo > result.standings[b].elo;
+    });
+
+    out << left << setw(16) << "Engine" << right << setw(9) << "Elo" << setw(9) << "Score" << setw(20) << "W/D/L"
+        << setw(13) << "CPU us/move" << setw(14) << "nodes/move" << endl;
+    for (int i : order) {
+        const EngineStanding &s = result.standings[i];
+        double score = s.games > 0 ? 100.0 * (s.wins + 0.5 * s.draws) / s.games : 0;
+        string record = to_string(s.wins) + "/" + to_string(s.draws) + "/" + to_string(s.losses);
+        double moves = max(1LL, s.moves);
+        out << left << setw(16) << result.engines[i].name << right << showpos << setw(9) << s.elo << noshowpos
+            << setw(8) << score << "%" << setw(20) << record << setw(13) << s.cpu_ns / moves / 1e3
+            << setw(14) << s.nodes / moves << endl;
+    }
+
+    out << "Pairings (points of the first engine):" << endl;
+    for (int a = 0; a < n; a++) {
+        for (int b = a + 1; b < n; b++) {
+            out << "  " << result.engines[a].name << " vs " << result.engines[b].name << ": "
+                << result.points[a][b] << " / " << result.games[a][b] << endl;
+        }
+    }
+}
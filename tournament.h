@@ -0,0 +1,143 @@
+/*
+ * File: tournament.h
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * Round-robin tournament between engine configurations, to compare their strength per CPU millisecond.
+ * Every pair of engines plays every opening of a fixed set twice, once with each color. The games run in parallel
+ * on worker threads; each game draws its random numbers (MCTS playouts included) from its own generator, seeded
+ * with the tournament seed and the game's number, so the results don't depend on the number of workers.
+ * The results are Elo ratings fitted to all games at once (Bradley-Terry, draws count half), with each engine's
+ * score and its average CPU time and nodes per move.
+ */
+
+#ifndef _tournament_h
+#define _tournament_h
+
+#include "bitboard.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// How an engine picks its moves
+enum EngineKind {
+    // ai_cell() at a difficulty level ('E', 'N', 'I', 'R' or any level changed with the command line options)
+    ENGINE_LEVEL,
+
+    // softmax_cell() over analyze_root() at a temperature
+    ENGINE_SOFTMAX,
+
+    // mcts_cell() with a playout or time budget per move
+    ENGINE_MCTS,
+
+    // anytime_cell() with a node or time budget per move
+    ENGINE_ANYTIME
+};
+
+// One engine of a tournament
+struct EngineConfig {
+    // The spec it was parsed from (see parse_engine())
+    string name;
+
+    EngineKind kind;
+
+    // Difficulty level of ENGINE_LEVEL
+    char level;
+
+    // Temperature of ENGINE_SOFTMAX
+    double temperature;
+
+    // Budget per move of ENGINE_MCTS and ENGINE_ANYTIME (0 for no limit; one of them is set). playouts is the
+    // anytime search's node budget.
+    long long playouts;
+    long long time_ms;
+};
+
+// Standing of one engine
+struct EngineStanding {
+    long long games;
+    long long wins;
+    long long draws;
+    long long losses;
+
+    // Elo rating, relative to the average of every engine in the tournament
+    double elo;
+
+    // Moves played, and the thread CPU time and nodes (positions searched or playouts) they took
+    long long moves;
+    long long cpu_ns;
+    long long nodes;
+};
+
+// Results of a tournament
+struct TournamentResult {
+    vector<EngineConfig> engines;
+    vector<EngineStanding> standings;
+
+    // points[i][j]: points engine i scored against engine j (1 per win, 0.5 per draw), out of games[i][j]
+    vector<vector<double> > points;
+    vector<vector<long long> > games;
+
+    // Number of openings, games played and wall time of the whole tournament
+    int openings;
+    long long total_games;
+    double seconds;
+};
+
+/*
+ * Function: parse_engine()
+ * Description: Parses an engine spec: a difficulty level ("E", "N", "I" or "R"), "softmax:T" for sampling with
+ *              temperature T, "mcts:P" for MCTS with P playouts per move, "mcts:Tms" for MCTS with T milliseconds
+ *              per move, or "anytime:N" / "anytime:Tms" for the anytime search with N positions or T milliseconds
+ *              per move.
+ * Parameter(s):
+ *     spec: Engine spec.
+ *     engine: Set to the parsed engine.
+ * Returns: Boolean value; true if the spec is valid, false otherwise.
+ */
+bool parse_engine(const string &spec, EngineConfig &engine);
+
+/*
+ * Function: opening_positions()
+ * Description: Returns every position reached after the given number of plies from the empty board that isn't
+ *              already over, one per set of symmetric positions, in order of their canonical keys.
+ * Parameter(s):
+ *     plies: Number of moves already played (0 is just the empty board).
+ * Returns: Vector of opening positions.
+ */
+vector<Bitboard> opening_positions(int plies);
+
+/*
+ * Function: run_tournament()
+ * Description: Plays a round-robin tournament on the current board size (see set_board_size()). Every pair of
+ *              engines plays every opening once with each color, repeated for every round. Games run on worker
+ *              threads, and each game draws its random numbers from its own generator (seeded from seed and the
+ *              game's number), so the games are the same for any number of workers unless an engine has a time
+ *              budget. Search threads are set to 1 for the run and restored afterwards.
+ * Parameter(s):
+ *     engines: Engines taking part (at least 2).
+ *     rounds: Number of times every game is played.
+ *     opening_plies: Plies of the openings (see opening_positions()).
+ *     workers: Number of worker threads (at least 1).
+ *     seed: Seed for the random moves.
+ * Returns: Results of the tournament.
+ */
+TournamentResult run_tournament(const vector<EngineConfig> &engines, int rounds, int opening_plies, int workers,
+                                unsigned seed);
+
+/*
+ * Function: print_tournament()
+ * Description: Prints the standings (sorted by Elo) and the score of every pairing.
+ * Parameter(s):
+ *     out: Stream to print to.
+ *     result: Results returned by run_tournament().
+ * Returns: Void.
+ */
+void print_tournament(ostream &out, const TournamentResult &result);
+
+#endif
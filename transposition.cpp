@@ -0,0 +1,298 @@
+/*
+ * File: transposition.cpp
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * This file defines the functions declared in 'transposition.h'.
+ * Notes:
+ * Comments in this file are implementation level.
+ * More details regarding the purpose and use of each function can be found in 'transposition.h'.
+ */
+
+#include "transposition.h"
+#include "tictactoe_helper.h"
+#include <cstring>
+#include <fstream>
+
+// Look up where the cell goes
+int transform_cell(int cell, int symmetry) {
+    return geometry().symmetry[symmetry][cell];
+}
+
+// Look up where the cell came from
+int untransform_cell(int cell, int symmetry) {
+    return geometry().inverse_symmetry[symmetry][cell];
+}
+
+// Move every piece of both masks
+Bitboard transform_board(const Bitboard &board, int symmetry) {
+    const vector<int> &cells = geometry().symmetry[symmetry];
+    Bitboard moved = {BoardMask(), BoardMask()};
+
+    BoardMask pieces = board.x;
+    while (any_cell(pieces)) {
+        add_cell(moved.x, cells[pop_cell(pieces)]);
+    }
+    pieces = board.o;
+    while (any_cell(pieces)) {
+        add_cell(moved.o, cells[pop_cell(pieces)]);
+    }
+    return moved;
+}
+
+// Mix the bits of a word (finalizer of MurmurHash3)
+static uint64_t mix(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+}
+
+// X mask in bits 0-31, O mask in bits 32-63, or a hash for boards with more than 32 cells
+uint64_t board_key(const Bitboard &board) {
+    if (geometry().cells <= 32) {
+        return board.x.words[0] | (board.o.words[0] << 32);
+    }
+
+    uint64_t key = 0;
+    for (int i = 0; i < MASK_WORDS; i++) {
+        key = mix(key ^ board.x.words[i]);
+        key = mix(key ^ board.o.words[i]);
+    }
+    return key;
+}
+
+// Smallest key of the 8 symmetric boards
+uint64_t canonical_key(const Bitboard &board, int &symmetry) {
+    uint64_t smallest = board_key(board);
+    symmetry = 0;
+    for (int s = 1; s < SYMMETRY_COUNT; s++) {
+        uint64_t key = board_key(transform_board(board, s));
+        if (key < smallest) {
+            smallest = key;
+            symmetry = s;
+        }
+    }
+    return smallest;
+}
+
+// Allocate every slot up front so the search never allocates
+TranspositionTable::TranspositionTable(int size_bits) {
+    entry_count = (size_t)1 << size_bits;
+    entries.reset(new Entry[entry_count]);
+    mask = entry_count - 1;
+    clear();
+}
+
+// Mix the bits of the key so that neighbouring keys spread across the table
+size_t TranspositionTable::slot(uint64_t key) const {
+    return mix(key) & mask;
+}
+
+// Each thread gets its own set of counters (threads beyond COUNTER_STRIPES share)
+// so a plain load and store can be used instead of a locked increment; a shared stripe may lose the odd count.
+static int counter_stripe() {
+    static atomic<int> next_stripe(0);
+    static thread_local int stripe = next_stripe.fetch_add(1) % COUNTER_STRIPES;
+    return stripe;
+}
+
+// Find the canonical key, then map the move back onto this board
+bool TranspositionTable::lookup(const Bitboard &board, TableEntry &entry) {
+    int symmetry;
+    uint64_t key = canonical_key(board, symmetry);
+    if (!lookup_key(key, entry)) {
+        return false;
+    }
+    if (entry.best_cell >= 0) {
+        entry.best_cell = untransform_cell(entry.best_cell, symmetry);
+    }
+    return true;
+}
+
+// Find the canonical key in its slot
+bool TranspositionTable::lookup_key(uint64_t key, TableEntry &entry) {
+    const Entry &slot_entry = entries[slot(key)];
+    Counters &counter = counters[counter_stripe()];
+
+    uint64_t data = slot_entry.data.load(memory_order_relaxed);
+    uint64_t check = slot_entry.check.load(memory_order_relaxed);
+
+    if ((check ^ data) == key + 1) {
+        entry.value = (int8_t)(data & 0xFF);
+        entry.bound = (Bound)((data >> 8) & 0xFF);
+        int best_cell = (data >> 16) & 0xFFFF;
+        entry.best_cell = (best_cell == 0xFFFF) ? -1 : best_cell;
+        counter.hits.store(counter.hits.load(memory_order_relaxed) + 1, memory_order_relaxed);
+        return true;
+    }
+
+    counter.misses.store(counter.misses.load(memory_order_relaxed) + 1, memory_order_relaxed);
+    return false;
+}
+
+// Store the move on the canonical board so every symmetric copy can use it
+void TranspositionTable::store(const Bitboard &board, const TableEntry &entry) {
+    int symmetry;
+    uint64_t key = canonical_key(board, symmetry);
+    TableEntry canonical = entry;
+    if (entry.best_cell >= 0) {
+        canonical.best_cell = transform_cell(entry.best_cell, symmetry);
+    }
+    store_key(key, canonical);
+}
+
+// Always replace the slot (the newest search of a position is as good as any older one)
+void TranspositionTable::store_key(uint64_t key, const TableEntry &entry) {
+    uint64_t best_cell = (entry.best_cell < 0) ? 0xFFFF : entry.best_cell;
+    uint64_t data = (uint64_t)(uint8_t)entry.value | ((uint64_t)entry.bound << 8) | (best_cell << 16);
+    put(key, data);
+}
+
+// Count the slot as filled the first time anything is written to it
+void TranspositionTable::put(uint64_t key, uint64_t data) {
+    Entry &slot_entry = entries[slot(key)];
+    if (slot_entry.check.load(memory_order_relaxed) == 0 && slot_entry.data.load(memory_order_relaxed) == 0) {
+        atomic<long long> &filled = counters[counter_stripe()].filled;
+        filled.store(filled.load(memory_order_relaxed) + 1, memory_order_relaxed);
+    }
+    slot_entry.data.store(data, memory_order_relaxed);
+    slot_entry.check.store((key + 1) ^ data, memory_order_relaxed);
+}
+
+// Reset every slot and counter (must not run while another thread is searching)
+void TranspositionTable::clear() {
+    for (size_t i = 0; i < entry_count; i++) {
+        entries[i].check.store(0, memory_order_relaxed);
+        entries[i].data.store(0, memory_order_relaxed);
+    }
+    for (int i = 0; i < COUNTER_STRIPES; i++) {
+        counters[i].hits.store(0);
+        counters[i].misses.store(0);
+        counters[i].filled.store(0);
+    }
+}
+
+// FNV-1a hash of a block of bytes, continuing from hash
+static uint64_t fnv1a(const void *bytes, size_t count, uint64_t hash) {
+    const unsigned char *p = (const unsigned char *)bytes;
+    for (size_t i = 0; i < count; i++) {
+        hash = (hash ^ p[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static const uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+
+// Filled slots only: the key is recovered from check and data, so the file needs no slot indexes
+bool TranspositionTable::save(const string &path) const {
+    vector<uint64_t> keys;
+    vector<uint32_t> data;
+    for (size_t i = 0; i < entry_count; i++) {
+        uint64_t check = entries[i].check.load(memory_order_relaxed);
+        uint64_t packed = entries[i].data.load(memory_order_relaxed);
+        if (check == 0 && packed == 0) {
+            continue;
+        }
+        keys.push_back((check ^ packed) - 1);
+        data.push_back((uint32_t)packed);
+    }
+
+    CacheHeader out;
+    memset(&out, 0, sizeof(out));
+    memcpy(out.magic, CACHE_MAGIC, sizeof(out.magic));
+    out.version = CACHE_VERSION;
+    out.size = geometry().size;
+    out.win_length = geometry().win_length;
+    out.entries = keys.size();
+    out.checksum = fnv1a(data.data(), data.size() * sizeof(uint32_t),
+                         fnv1a(keys.data(), keys.size() * sizeof(uint64_t), FNV_OFFSET));
+
+    ofstream file(path, ios::binary | ios::trunc);
+    file.write((const char *)&out, sizeof(out));
+    file.write((const char *)keys.data(), keys.size() * sizeof(uint64_t));
+    file.write((const char *)data.data(), data.size() * sizeof(uint32_t));
+    file.close();
+    return !file.fail();
+}
+
+// The whole file is read at once, then checked before anything is stored
+bool TranspositionTable::load(const string &path) {
+    ifstream file(path, ios::binary | ios::ate);
+    if (!file) {
+        return false;
+    }
+    size_t bytes = file.tellg();
+    if (bytes < sizeof(CacheHeader)) {
+        return false;
+    }
+    vector<char> contents(bytes);
+    file.seekg(0);
+    if (!file.read(contents.data(), bytes)) {
+        return false;
+    }
+
+    CacheHeader header;
+    memcpy(&header, contents.data(), sizeof(header));
+    bool valid = memcmp(header.magic, CACHE_MAGIC, sizeof(header.magic)) == 0 && header.version == CACHE_VERSION
+                 && (int)header.size == geometry().size && (int)header.win_length == geometry().win_length
+                 && header.entries == (bytes - sizeof(CacheHeader)) / (sizeof(uint64_t) + sizeof(uint32_t))
+                 && bytes == sizeof(CacheHeader) + header.entries * (sizeof(uint64_t) + sizeof(uint32_t));
+    if (!valid) {
+        return false;
+    }
+    const char *keys = contents.data() + sizeof(CacheHeader);
+    const char *data = keys + header.entries * sizeof(uint64_t);
+    uint64_t checksum = fnv1a(data, header.entries * sizeof(uint32_t),
+                              fnv1a(keys, header.entries * sizeof(uint64_t), FNV_OFFSET));
+    if (checksum != header.checksum) {
+        return false;
+    }
+
+    // The arrays follow a 40 byte header, so they are copied out instead of read in place
+    for (uint64_t i = 0; i < header.entries; i++) {
+        uint64_t key;
+        uint32_t packed;
+        memcpy(&key, keys + i * sizeof(uint64_t), sizeof(key));
+        memcpy(&packed, data + i * sizeof(uint32_t), sizeof(packed));
+        put(key, packed);
+    }
+    return true;
+}
+
+// Add up the counters of every stripe
+long long TranspositionTable::hits() const {
+    long long total = 0;
+    for (int i = 0; i < COUNTER_STRIPES; i++) {
+        total += counters[i].hits.load();
+    }
+    return total;
+}
+
+long long TranspositionTable::misses() const {
+    long long total = 0;
+    for (int i = 0; i < COUNTER_STRIPES; i++) {
+        total += counters[i].misses.load();
+    }
+    return total;
+}
+
+long long TranspositionTable::size() const {
+    long long total = 0;
+    for (int i = 0; i < COUNTER_STRIPES; i++) {
+        total += counters[i].filled.load();
+    }
+    return total;
+}
+
+// One table for the whole process; 2^20 slots (16 MB) holds every canonical 3x3 position many times over
+// and the ~37,000 positions stored while solving the empty 4x4 board with room to spare
+TranspositionTable &transposition_table() {
+    static TranspositionTable table(20);
+    return table;
+}
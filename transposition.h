@@ -0,0 +1,230 @@
+/*
+ * File: transposition.h
+ * Author: Christopher Lin
+ * Date: 2026-10-16
+ *
+ * GitHub: https://github.com/titancoder12/CS12-TicTacToe
+ *
+ * Description:
+ * Transposition table shared by minimax(), min_value() and max_value().
+ * Positions are stored under the key of their canonical form: the smallest key among the 8 rotations and
+ * reflections of the board, so every symmetric copy of a position is only solved once.
+ * The table can be used by several searching threads at once without locks.
+ * The table lives as long as the process, and can be saved to a cache file and loaded back by a later process
+ * (see TranspositionTable::save()), so solved positions survive restarts too.
+ */
+
+#ifndef _transposition_h
+#define _transposition_h
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "bitboard.h"
+
+using namespace std;
+
+/*
+ * Function: transform_cell()
+ * Description: Maps a cell index through one of the 8 board symmetries.
+ * Parameter(s):
+ *     cell: Cell index (row * SIZE + col).
+ *     symmetry: Index of the symmetry (0 is the identity).
+ * Returns: Cell index the cell moves to.
+ */
+int transform_cell(int cell, int symmetry);
+
+/*
+ * Function: untransform_cell()
+ * Description: Undoes transform_cell(); maps a cell of the transformed board back to the original board.
+ * Parameter(s):
+ *     cell: Cell index (row * SIZE + col) on the transformed board.
+ *     symmetry: Index of the symmetry that was applied.
+ * Returns: Cell index on the original board.
+ */
+int untransform_cell(int cell, int symmetry);
+
+/*
+ * Function: transform_board()
+ * Description: Applies one of the 8 board symmetries to both masks of a board.
+ * Parameter(s):
+ *     board: Bitboard repersenting the board.
+ *     symmetry: Index of the symmetry (0 is the identity).
+ * Returns: The transformed board.
+ */
+Bitboard transform_board(const Bitboard &board, int symmetry);
+
+/*
+ * Function: board_key()
+ * Description: Packs a board into an integer key (X mask in the low 32 bits, O mask in the high 32 bits).
+ *              Boards with more than 32 cells don't fit, so their key is a 64 bit hash of both masks instead
+ *              (different boards can then share a key, although it is very unlikely).
+ * Parameter(s):
+ *     board: Bitboard repersenting the board.
+ * Returns: Key identifying the board.
+ */
+uint64_t board_key(const Bitboard &board);
+
+/*
+ * Function: canonical_key()
+ * Description: Returns the smallest key among all 8 symmetric copies of the board.
+ *              Symmetric boards always share the same canonical key.
+ * Parameter(s):
+ *     board: Bitboard repersenting the board.
+ *     symmetry: Set to the symmetry that turns the board into its canonical form.
+ * Returns: Canonical key of the board.
+ */
+uint64_t canonical_key(const Bitboard &board, int &symmetry);
+
+// What a stored value says about the real utility of a position.
+// Alpha-beta cutoffs only prove that the utility is at least (LOWER) or at most (UPPER) the stored value.
+enum Bound {
+    BOUND_EXACT,
+    BOUND_LOWER,
+    BOUND_UPPER
+};
+
+// Everything remembered about a solved position
+struct TableEntry {
+    int value;
+    Bound bound;
+    // Best move found for the position (cell index on the board passed to lookup/store), -1 if none
+    int best_cell;
+};
+
+// Cache file identification and version (see TranspositionTable::save())
+const char CACHE_MAGIC[8] = {'T', 'T', 'T', 'C', 'A', 'C', 'H', 'E'};
+const uint32_t CACHE_VERSION = 1;
+
+// Start of a cache file. It is followed by the canonical keys of the stored positions (8 bytes each),
+// then their packed entries (4 bytes each, as in the table's slots). checksum is the FNV-1a hash of both arrays.
+struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t size;
+    uint32_t win_length;
+    uint32_t reserved;
+    uint64_t entries;
+    uint64_t checksum;
+};
+
+// Number of separate counter sets (threads count lookups on their own set, see counter_stripe())
+const int COUNTER_STRIPES = 64;
+
+// Fixed-size hash table from canonical keys to solved utilities and best moves
+class TranspositionTable {
+public:
+    /*
+     * Function: TranspositionTable()
+     * Description: Creates an empty table with 2^size_bits slots.
+     * Parameter(s):
+     *     size_bits: Base 2 logarithm of the number of slots.
+     */
+    TranspositionTable(int size_bits);
+
+    /*
+     * Function: lookup()
+     * Description: Looks up a board (or any of its symmetric copies). Counts a hit or a miss.
+     *              The best move is mapped back onto the given board, whichever copy was stored.
+     * Parameter(s):
+     *     board: Bitboard repersenting the board.
+     *     entry: Set to the stored value, bound and best move if the board was found.
+     * Returns: True if the board was found, false otherwise.
+     */
+    bool lookup(const Bitboard &board, TableEntry &entry);
+
+    /*
+     * Function: store()
+     * Description: Stores a searched board under its canonical key, replacing whatever used the slot.
+     * Parameter(s):
+     *     board: Bitboard repersenting the board.
+     *     entry: Value, bound and best move (cell index on the given board) of the search.
+     * Returns: Void.
+     */
+    void store(const Bitboard &board, const TableEntry &entry);
+
+    /*
+     * Function: lookup_key() / store_key()
+     * Description: lookup() and store() for a caller that already has the canonical key (see canonical_key());
+     *              the best move is on the canonical board instead of the caller's board.
+     * Parameter(s):
+     *     key: Canonical key of the board.
+     *     entry: Entry to fill or to store.
+     */
+    bool lookup_key(uint64_t key, TableEntry &entry);
+    void store_key(uint64_t key, const TableEntry &entry);
+
+    /*
+     * Function: clear()
+     * Description: Empties the table and resets the counters.
+     * Parameter(s):
+     * Returns: Void.
+     */
+    void clear();
+
+    /*
+     * Function: save()
+     * Description: Writes every stored position to a cache file (see CacheHeader), tagged with the current board
+     *              size and win length. Must not run while another thread is searching.
+     * Parameter(s):
+     *     path: File to write (replaced if it exists).
+     * Returns: True if the file was written, false otherwise.
+     */
+    bool save(const string &path) const;
+
+    /*
+     * Function: load()
+     * Description: Reads a cache file written by save() with a single read and stores its positions in the table.
+     *              The file is ignored unless its magic, version, board size, win length, length and checksum all
+     *              match. Must not run while another thread is searching.
+     * Parameter(s):
+     *     path: File to read.
+     * Returns: True if the positions were loaded, false if the file is missing or doesn't match.
+     */
+    bool load(const string &path);
+
+    // Counters (number of successful lookups, failed lookups and filled slots)
+    long long hits() const;
+    long long misses() const;
+    long long size() const;
+
+private:
+    // Slots are read and written by several threads without locks. data packs the value (bits 0-7), the bound
+    // (bits 8-15) and the best move on the canonical board (bits 16-31, 0xFFFF if none); check is
+    // (canonical key + 1) XOR data. If two threads write the slot at the same time and the halves get mixed up,
+    // check XOR data no longer gives the key, so the slot reads as a miss instead of returning wrong data.
+    struct Entry {
+        atomic<uint64_t> check;
+        atomic<uint64_t> data;
+    };
+
+    // Counters of one stripe, on their own cache line so threads don't slow each other down
+    struct alignas(64) Counters {
+        atomic<long long> hits;
+        atomic<long long> misses;
+        atomic<long long> filled;
+    };
+
+    // Slot index of a canonical key
+    size_t slot(uint64_t key) const;
+
+    // Write packed data under a canonical key, replacing whatever used the slot
+    void put(uint64_t key, uint64_t data);
+
+    unique_ptr<Entry[]> entries;
+    size_t entry_count;
+    size_t mask;
+    Counters counters[COUNTER_STRIPES];
+};
+
+/*
+ * Function: transposition_table()
+ * Description: Returns the table shared by minimax(), min_value() and max_value().
+ * Parameter(s):
+ * Returns: Reference to the shared table.
+ */
+TranspositionTable &transposition_table();
+
+#endif